@@ -0,0 +1,297 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "AhoCorasick.hpp"
+#include <algorithm>
+
+///////////////////////////////////////////////////////////////////////////////
+// Namespace Ax
+///////////////////////////////////////////////////////////////////////////////
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+using sizeType = size_t;
+
+///////////////////////////////////////////////////////////////////////////////
+TAhoCorasick::Scanner::Scanner(const TAhoCorasick& Automaton)
+    : _automaton(&Automaton)
+{}
+
+///////////////////////////////////////////////////////////////////////////////
+void TAhoCorasick::Scanner::Feed(const char* Data, size_t Len,
+    std::vector<Match>& Matches)
+{
+    _automaton->_scan(Data, Len, _state, _offset, &Matches);
+    _offset += Len;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TAhoCorasick::Scanner::Feed(const TString& Chunk,
+    std::vector<Match>& Matches)
+{
+    Feed(Chunk.CStr(), Chunk.Length(), Matches);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TAhoCorasick::Scanner::Reset(void)
+{
+    _state = 0;
+    _offset = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+sizeType TAhoCorasick::Scanner::Offset(void) const
+{
+    return (_offset);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TAhoCorasick::TAhoCorasick(void)
+{
+    Clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TAhoCorasick::TAhoCorasick(const std::vector<TString>& Patterns)
+{
+    Clear();
+    for (const TString& Pattern : Patterns)
+        Add(Pattern);
+    Build();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+sizeType TAhoCorasick::Add(const TString& Pattern)
+{
+    return (Add(Pattern.CStr(), Pattern.Length()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+sizeType TAhoCorasick::Add(const char* Pattern, size_t Len)
+{
+    const sizeType Id = _lengths.size();
+    uint32_t Node = 0;
+
+    _lengths.push_back(Len);
+    if (Len == 0)
+        return (Id);
+    for (sizeType i = 0; i < Len; ++i)
+    {
+        const unsigned char Ch = static_cast<unsigned char>(Pattern[i]);
+        uint32_t Next = 0;
+
+        for (const auto& Edge : _trie[Node].Edges)
+        {
+            if (Edge.first == Ch)
+            {
+                Next = Edge.second;
+                break;
+            }
+        }
+        if (Next == 0)
+        {
+            Next = static_cast<uint32_t>(_trie.size());
+            _trie[Node].Edges.emplace_back(Ch, Next);
+            _trie.emplace_back();
+        }
+        Node = Next;
+    }
+    _trie[Node].Outputs.push_back(static_cast<uint32_t>(Id));
+    return (Id);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TAhoCorasick::Build(void)
+{
+    const size_t Count = _trie.size();
+    std::vector<uint32_t> Order;
+    std::vector<uint32_t> NewId(Count, 0);
+
+    // Number the nodes in breadth-first order so that the nodes visited
+    // right after the root sit next to each other in the flat tables.
+    Order.reserve(Count);
+    Order.push_back(0);
+    for (size_t i = 0; i < Order.size(); ++i)
+    {
+        auto& Edges = _trie[Order[i]].Edges;
+        std::sort(Edges.begin(), Edges.end());
+        for (const auto& Edge : Edges)
+        {
+            NewId[Edge.second] = static_cast<uint32_t>(Order.size());
+            Order.push_back(Edge.second);
+        }
+    }
+
+    _edgeBegin.assign(1, 0);
+    _edgeLabel.clear();
+    _edgeTarget.clear();
+    _outBegin.assign(1, 0);
+    _outPattern.clear();
+    std::fill(_root, _root + 256, 0);
+    for (uint32_t Old : Order)
+    {
+        for (const auto& Edge : _trie[Old].Edges)
+        {
+            if (Old == 0)
+                _root[Edge.first] = NewId[Edge.second];
+            _edgeLabel.push_back(Edge.first);
+            _edgeTarget.push_back(NewId[Edge.second]);
+        }
+        _edgeBegin.push_back(static_cast<uint32_t>(_edgeLabel.size()));
+        _outPattern.insert(_outPattern.end(), _trie[Old].Outputs.begin(),
+            _trie[Old].Outputs.end());
+        _outBegin.push_back(static_cast<uint32_t>(_outPattern.size()));
+    }
+
+    // Failure and dictionary links, parents are always resolved before
+    // their children in breadth-first order.
+    _fail.assign(Count, 0);
+    _dict.assign(Count, 0);
+    for (uint32_t Node = 0; Node < Count; ++Node)
+    {
+        for (uint32_t e = _edgeBegin[Node]; e < _edgeBegin[Node + 1]; ++e)
+        {
+            const uint32_t Child = _edgeTarget[e];
+            _fail[Child] = Node ? _step(_fail[Node], _edgeLabel[e]) : 0;
+        }
+        if (_outBegin[Node] != _outBegin[Node + 1])
+            _dict[Node] = Node;
+        else if (Node)
+            _dict[Node] = _dict[_fail[Node]];
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TAhoCorasick::Clear(void)
+{
+    _trie.assign(1, TrieNode());
+    _lengths.clear();
+    Build();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t TAhoCorasick::PatternCount(void) const
+{
+    return (_lengths.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<TAhoCorasick::Match> TAhoCorasick::FindAll(
+    const TString& Text) const
+{
+    return (FindAll(Text.CStr(), Text.Length()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<TAhoCorasick::Match> TAhoCorasick::FindAll(const char* Data,
+    size_t Len) const
+{
+    std::vector<Match> Matches;
+    uint32_t State = 0;
+
+    _scan(Data, Len, State, 0, &Matches);
+    return (Matches);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TAhoCorasick::ContainsAny(const TString& Text) const
+{
+    uint32_t State = 0;
+
+    return (_scan(Text.CStr(), Text.Length(), State, 0, nullptr));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+uint32_t TAhoCorasick::_step(uint32_t State, unsigned char Ch) const
+{
+    while (State != 0)
+    {
+        const uint32_t Next = _child(State, Ch);
+        if (Next != 0)
+            return (Next);
+        State = _fail[State];
+    }
+    return (_root[Ch]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+uint32_t TAhoCorasick::_child(uint32_t State, unsigned char Ch) const
+{
+    uint32_t First = _edgeBegin[State];
+    uint32_t Last = _edgeBegin[State + 1];
+
+    if (Last - First <= 8)
+    {
+        for (; First < Last; ++First)
+        {
+            if (_edgeLabel[First] == Ch)
+                return (_edgeTarget[First]);
+        }
+        return (0);
+    }
+    const unsigned char* Labels = _edgeLabel.data();
+    const unsigned char* It = std::lower_bound(Labels + First, Labels + Last,
+        Ch);
+    if (It != Labels + Last && *It == Ch)
+        return (_edgeTarget[It - Labels]);
+    return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TAhoCorasick::_scan(const char* Data, size_t Len, uint32_t& State,
+    sizeType Offset, std::vector<Match>* Matches) const
+{
+    const unsigned char* Bytes = reinterpret_cast<const unsigned char*>(Data);
+    bool Found = false;
+
+    for (sizeType i = 0; i < Len; ++i)
+    {
+        State = _step(State, Bytes[i]);
+        uint32_t Node = _dict[State];
+        if (Node == 0)
+            continue;
+        Found = true;
+        if (!Matches)
+            return (true);
+        const sizeType End = Offset + i + 1;
+        while (Node != 0)
+        {
+            for (uint32_t o = _outBegin[Node]; o < _outBegin[Node + 1]; ++o)
+            {
+                const uint32_t Id = _outPattern[o];
+                Matches->push_back({End - _lengths[Id], Id});
+            }
+            Node = _dict[_fail[Node]];
+        }
+    }
+    return (Found);
+}
+
+} // namespace Ax
@@ -0,0 +1,303 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Pragma once
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "String.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Multi-pattern matcher built on the Aho-Corasick automaton.
+///
+/// Patterns are added with `Add` and compiled once with `Build`. The compiled
+/// automaton keeps a dense 256-entry transition row for the root, where most
+/// of the traffic goes, and sorted sparse edge lists for every other node, all
+/// stored in flat arrays in breadth-first order. A text is scanned in a single
+/// pass regardless of the number of patterns.
+///
+///////////////////////////////////////////////////////////////////////////////
+class TAhoCorasick
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    using sizeType = size_t;        //<! Type alias for size type.
+    static const size_t npos = -1;  //<! The largest possible value.
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A single occurrence of a pattern in the scanned text.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    struct Match
+    {
+        sizeType Position;  //<! Offset of the first matched character.
+        sizeType Pattern;   //<! Identifier returned by `Add`.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Incremental scanner feeding a text to the automaton in chunks.
+    ///
+    /// The scanner keeps the automaton state and the absolute offset between
+    /// calls to `Feed`, so occurrences spanning two buffers are reported as
+    /// if the whole text had been scanned at once.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    class Scanner
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Constructs a scanner over a built automaton.
+        ///
+        /// \param Automaton The automaton to run, it must outlive the scanner.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        Scanner(const TAhoCorasick& Automaton);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Scans the next chunk of the text.
+        ///
+        /// \param Data Pointer to the chunk.
+        /// \param Len Length of the chunk.
+        /// \param Matches Receives the occurrences ending inside the chunk,
+        /// positions are relative to the start of the whole stream.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        void Feed(const char* Data, size_t Len, std::vector<Match>& Matches);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Scans the next chunk of the text.
+        ///
+        /// \param Chunk The chunk to scan.
+        /// \param Matches Receives the occurrences ending inside the chunk.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        void Feed(const TString& Chunk, std::vector<Match>& Matches);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Restarts the scanner at the beginning of a new stream.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        void Reset(void);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Number of bytes fed since the last reset.
+        ///
+        /// \return The absolute offset of the next byte.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        sizeType Offset(void) const;
+
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Private member data.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        const TAhoCorasick* _automaton; //<! Automaton being run.
+        uint32_t _state = 0;            //<! Current automaton state.
+        sizeType _offset = 0;           //<! Absolute offset of the next byte.
+    };
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs an empty automaton.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TAhoCorasick(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs and builds an automaton from a set of patterns.
+    ///
+    /// \param Patterns The patterns, their identifiers are their indices.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TAhoCorasick(const std::vector<TString>& Patterns);
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds a pattern to the automaton.
+    ///
+    /// The automaton must be rebuilt with `Build` before the new pattern can
+    /// be found. Empty patterns are accepted but never reported.
+    ///
+    /// \param Pattern The pattern to add.
+    ///
+    /// \return The identifier reported with the occurrences of the pattern.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType Add(const TString& Pattern);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds a pattern to the automaton.
+    ///
+    /// \param Pattern Pointer to the pattern.
+    /// \param Len Length of the pattern.
+    ///
+    /// \return The identifier reported with the occurrences of the pattern.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType Add(const char* Pattern, size_t Len);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Compiles the added patterns into the transition tables.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Build(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Removes every pattern.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Clear(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Number of patterns added so far.
+    ///
+    /// \return The pattern count.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    size_t PatternCount(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds every occurrence of every pattern in a text.
+    ///
+    /// Occurrences are reported in order of their end position, longest
+    /// pattern first when several end at the same position.
+    ///
+    /// \param Text The text to scan.
+    ///
+    /// \return The occurrences found.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<Match> FindAll(const TString& Text) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds every occurrence of every pattern in a buffer.
+    ///
+    /// \param Data Pointer to the buffer.
+    /// \param Len Length of the buffer.
+    ///
+    /// \return The occurrences found.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<Match> FindAll(const char* Data, size_t Len) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Tells whether any pattern occurs in a text.
+    ///
+    /// Stops at the first occurrence.
+    ///
+    /// \param Text The text to scan.
+    ///
+    /// \return True if at least one pattern occurs in the text.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool ContainsAny(const TString& Text) const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Follows the transition on a character, falling back along the
+    /// failure links when the current node has no matching edge.
+    ///
+    /// \param State The current state.
+    /// \param Ch The next character.
+    ///
+    /// \return The next state.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    uint32_t _step(uint32_t State, unsigned char Ch) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Looks up the goto edge of a non-root node.
+    ///
+    /// \param State The node.
+    /// \param Ch The edge label.
+    ///
+    /// \return The child node, or 0 when there is no such edge.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    uint32_t _child(uint32_t State, unsigned char Ch) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Runs the automaton over a buffer.
+    ///
+    /// \param Data Pointer to the buffer.
+    /// \param Len Length of the buffer.
+    /// \param State In: the starting state. Out: the final state.
+    /// \param Offset Absolute offset of the first byte of the buffer.
+    /// \param Matches Receives the occurrences, or null to stop at the first.
+    ///
+    /// \return True if at least one occurrence was found.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool _scan(const char* Data, size_t Len, uint32_t& State, sizeType Offset,
+        std::vector<Match>* Matches) const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Trie node used while patterns are being added.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    struct TrieNode
+    {
+        std::vector<std::pair<unsigned char, uint32_t>> Edges; //<! Children.
+        std::vector<uint32_t> Outputs;  //<! Patterns ending at this node.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Private member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<TrieNode> _trie;            //<! Trie of the added patterns.
+    std::vector<size_t> _lengths;           //<! Length of every pattern.
+    uint32_t _root[256] = {};               //<! Dense transitions of the root.
+    std::vector<uint32_t> _edgeBegin;       //<! First edge of every node.
+    std::vector<unsigned char> _edgeLabel;  //<! Sorted edge labels.
+    std::vector<uint32_t> _edgeTarget;      //<! Edge targets.
+    std::vector<uint32_t> _fail;            //<! Failure links.
+    std::vector<uint32_t> _dict;            //<! Next node with an output.
+    std::vector<uint32_t> _outBegin;        //<! First output of every node.
+    std::vector<uint32_t> _outPattern;      //<! Pattern identifiers.
+};
+
+} // namespace Ax
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Export to global namespace.
+///
+///////////////////////////////////////////////////////////////////////////////
+typedef Ax::TAhoCorasick FAhoCorasick;
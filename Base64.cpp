@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Base64.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// Namespace Ax
+///////////////////////////////////////////////////////////////////////////////
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+using sizeType = size_t;
+
+///////////////////////////////////////////////////////////////////////////////
+TBase64Encoder::TBase64Encoder(Alphabet Digits, bool Padding)
+    : _digits(Digits), _padding(Padding)
+{}
+
+///////////////////////////////////////////////////////////////////////////////
+void TBase64Encoder::Update(const char* Data, size_t Len, TString& Out)
+{
+    if (_restLen > 0)
+    {
+        while (_restLen < 3 && Len > 0)
+        {
+            _rest[_restLen++] = *Data++;
+            Len--;
+        }
+        if (_restLen < 3)
+            return;
+        Out.AppendBase64(_rest, 3, _digits);
+        _restLen = 0;
+    }
+
+    const size_t Whole = Len / 3 * 3;
+    Out.AppendBase64(Data, Whole, _digits);
+    for (size_t i = Whole; i < Len; ++i)
+        _rest[_restLen++] = Data[i];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TBase64Encoder::Finish(TString& Out)
+{
+    Out.AppendBase64(_rest, _restLen, _digits, _padding);
+    _restLen = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TBase64Decoder::TBase64Decoder(Alphabet Digits) : _digits(Digits) {}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TBase64Decoder::Update(const char* Data, size_t Len, TString& Out)
+{
+    if (_error != npos)
+        return (false);
+    if (_ended && Len > 0)
+    {
+        _error = _consumed;
+        return (false);
+    }
+    if (_restLen > 0)
+    {
+        while (_restLen < 4 && Len > 0)
+        {
+            _rest[_restLen++] = *Data++;
+            Len--;
+        }
+        if (_restLen < 4)
+            return (true);
+        _restLen = 0;
+        if (!_decode(_rest, 4, Out))
+            return (false);
+    }
+
+    const size_t Whole = Len / 4 * 4;
+    if (!_decode(Data, Whole, Out))
+        return (false);
+    if (_ended && Whole < Len)
+    {
+        _error = _consumed;
+        return (false);
+    }
+    for (size_t i = Whole; i < Len; ++i)
+        _rest[_restLen++] = Data[i];
+    return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TBase64Decoder::Finish(TString& Out)
+{
+    if (_error != npos || !_decode(_rest, _restLen, Out))
+        return (false);
+    _restLen = 0;
+    _consumed = 0;
+    _ended = false;
+    return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+sizeType TBase64Decoder::ErrorOffset(void) const
+{
+    return (_error);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TBase64Decoder::_decode(const char* Data, size_t Len, TString& Out)
+{
+    sizeType At = npos;
+
+    if (Len == 0)
+        return (true);
+    if (!Out.AppendFromBase64(Data, Len, _digits, &At))
+    {
+        _error = _consumed + At;
+        return (false);
+    }
+    _consumed += Len;
+    _ended = Data[Len - 1] == '=';
+    return (true);
+}
+
+} // namespace Ax
@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Pragma once
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "String.hpp"
+
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Base64 encoder for data that arrives in pieces.
+///
+/// Whole 3-byte groups are encoded as they come in with
+/// `TString::AppendBase64`; at most two bytes are held back between calls.
+///
+///////////////////////////////////////////////////////////////////////////////
+class TBase64Encoder
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    using Alphabet = TString::Base64Alphabet; //<! Digit sets.
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs an encoder.
+    ///
+    /// \param Digits The digit set.
+    /// \param Padding True to pad the last group with `=`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TBase64Encoder(Alphabet Digits = Alphabet::Standard, bool Padding = true);
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Encodes the next piece of the input.
+    ///
+    /// \param Data The bytes.
+    /// \param Len Number of bytes.
+    /// \param Out Receives the digits of every completed group.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Update(const char* Data, size_t Len, TString& Out);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Encodes the bytes held back and resets the encoder.
+    ///
+    /// \param Out Receives the digits of the last group.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Finish(TString& Out);
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Private member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    Alphabet _digits;           //<! Digit set.
+    bool _padding;              //<! True to pad the last group.
+    char _rest[3];              //<! Bytes of an unfinished group.
+    size_t _restLen = 0;        //<! Number of bytes in `_rest`.
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Base64 decoder for data that arrives in pieces.
+///
+/// Whole 4-digit groups are decoded as they come in with
+/// `TString::AppendFromBase64`; at most three digits are held back between
+/// calls. The input is validated as `TString::FromBase64` does, with error
+/// offsets counted from the start of the stream.
+///
+///////////////////////////////////////////////////////////////////////////////
+class TBase64Decoder
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    using sizeType = size_t;        //<! Type alias for size type.
+    static const size_t npos = -1;  //<! The largest possible value.
+    using Alphabet = TString::Base64Alphabet; //<! Digit sets.
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs a decoder.
+    ///
+    /// \param Digits The digit set.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TBase64Decoder(Alphabet Digits = Alphabet::Standard);
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes the next piece of the input.
+    ///
+    /// \param Data The digits.
+    /// \param Len Number of digits.
+    /// \param Out Receives the bytes of every completed group.
+    ///
+    /// \return False if the stream is invalid; every later call fails too.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool Update(const char* Data, size_t Len, TString& Out);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes the digits held back and, if the stream was valid,
+    /// resets the decoder for the next one.
+    ///
+    /// \param Out Receives the bytes of the last group.
+    ///
+    /// \return False if the stream is invalid.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool Finish(TString& Out);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves where the stream went wrong.
+    ///
+    /// \return The offset of the first invalid digit in the stream, or
+    /// `npos`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType ErrorOffset(void) const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes groups and moves the stream position past them.
+    ///
+    /// \param Data The digits.
+    /// \param Len Number of digits.
+    /// \param Out Receives the bytes.
+    ///
+    /// \return False if the digits are invalid.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool _decode(const char* Data, size_t Len, TString& Out);
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Private member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    Alphabet _digits;           //<! Digit set.
+    char _rest[4];              //<! Digits of an unfinished group.
+    size_t _restLen = 0;        //<! Number of digits in `_rest`.
+    size_t _consumed = 0;       //<! Digits decoded so far.
+    bool _ended = false;        //<! True once a padded group was decoded.
+    sizeType _error = npos;     //<! Offset of the first invalid digit.
+};
+
+} // namespace Ax
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Export to global namespace.
+///
+///////////////////////////////////////////////////////////////////////////////
+typedef Ax::TBase64Encoder FBase64Encoder;
+typedef Ax::TBase64Decoder FBase64Decoder;
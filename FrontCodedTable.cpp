@@ -0,0 +1,360 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "FrontCodedTable.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+///////////////////////////////////////////////////////////////////////////////
+// Namespace Ax
+///////////////////////////////////////////////////////////////////////////////
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+using sizeType = size_t;
+
+///////////////////////////////////////////////////////////////////////////////
+// Buffer layout: the "AXFC" tag, a 32-bit version, then the entry count, the
+// restart interval and the restart count as 64-bit values, one 64-bit offset
+// per restart point relative to the first entry, and the entries. An entry
+// is the varint length shared with the previous entry, the varint length of
+// the rest, and the rest; restart points share nothing.
+///////////////////////////////////////////////////////////////////////////////
+static const char _tableTag[4] = {'A', 'X', 'F', 'C'};
+static const uint32_t _tableVersion = 1;
+static const size_t _headerSize = 32;
+
+///////////////////////////////////////////////////////////////////////////////
+static inline uint64_t _readU64(const char* Ptr)
+{
+    uint64_t Value;
+    ::memcpy(&Value, Ptr, sizeof(Value));
+    return (Value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static inline void _writeU64(char* Ptr, uint64_t Value)
+{
+    ::memcpy(Ptr, &Value, sizeof(Value));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _writeVarint(std::vector<char>& Out, uint64_t Value)
+{
+    while (Value >= 0x80)
+    {
+        Out.push_back(static_cast<char>((Value & 0x7F) | 0x80));
+        Value >>= 7;
+    }
+    Out.push_back(static_cast<char>(Value));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static inline uint64_t _readVarint(const char*& Ptr)
+{
+    uint64_t Value = 0;
+    unsigned char Byte;
+
+    for (unsigned Shift = 0;; Shift += 7)
+    {
+        Byte = static_cast<unsigned char>(*Ptr++);
+        Value |= uint64_t(Byte & 0x7F) << Shift;
+        if (!(Byte & 0x80))
+            return (Value);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Reads a varint without going past `End`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static bool _readVarintChecked(const char*& Ptr, const char* End,
+    uint64_t& Value)
+{
+    Value = 0;
+    for (unsigned Shift = 0; Shift < 64 && Ptr < End; Shift += 7)
+    {
+        unsigned char Byte = static_cast<unsigned char>(*Ptr++);
+        Value |= uint64_t(Byte & 0x7F) << Shift;
+        if (!(Byte & 0x80))
+            return (true);
+    }
+    return (false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static inline bool _less(const char* A, size_t LenA, const char* B,
+    size_t LenB)
+{
+    const size_t Len = LenA < LenB ? LenA : LenB;
+    const int Diff = Len ? ::memcmp(A, B, Len) : 0;
+
+    return (Diff ? Diff < 0 : LenA < LenB);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TFrontCodedTable::TFrontCodedTable(void)
+{
+    Build(std::vector<TString>());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TFrontCodedTable::Build(const std::vector<TString>& Sorted,
+    size_t Interval)
+{
+    const size_t Count = Sorted.size();
+    const size_t Blocks = Interval ? (Count + Interval - 1) / Interval : 0;
+    std::vector<char> Data;
+
+    if (Interval == 0)
+        return (false);
+    for (sizeType i = 1; i < Count; ++i)
+    {
+        if (Sorted[i] < Sorted[i - 1])
+            return (false);
+    }
+
+    std::vector<char> Buffer(_headerSize + Blocks * 8);
+    ::memcpy(Buffer.data(), _tableTag, 4);
+    ::memcpy(Buffer.data() + 4, &_tableVersion, 4);
+    _writeU64(Buffer.data() + 8, Count);
+    _writeU64(Buffer.data() + 16, Interval);
+    _writeU64(Buffer.data() + 24, Blocks);
+    for (sizeType i = 0; i < Count; ++i)
+    {
+        const char* Str = Sorted[i].CStr();
+        const size_t Len = Sorted[i].Length();
+        size_t Shared = 0;
+
+        if (i % Interval == 0)
+            _writeU64(Buffer.data() + _headerSize + (i / Interval) * 8,
+                Data.size());
+        else
+        {
+            const char* Prev = Sorted[i - 1].CStr();
+            const size_t Max = std::min(Len, Sorted[i - 1].Length());
+            while (Shared < Max && Prev[Shared] == Str[Shared])
+                Shared++;
+        }
+        _writeVarint(Data, Shared);
+        _writeVarint(Data, Len - Shared);
+        Data.insert(Data.end(), Str + Shared, Str + Len);
+    }
+    Buffer.insert(Buffer.end(), Data.begin(), Data.end());
+
+    _buffer.swap(Buffer);
+    _count = Count;
+    _interval = Interval;
+    _blocks = Blocks;
+    return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TFrontCodedTable::FromBuffer(std::vector<char> Buffer)
+{
+    if (Buffer.size() < _headerSize ||
+        ::memcmp(Buffer.data(), _tableTag, 4) != 0)
+        return (false);
+
+    uint32_t Version;
+    ::memcpy(&Version, Buffer.data() + 4, 4);
+    const uint64_t Count = _readU64(Buffer.data() + 8);
+    const uint64_t Interval = _readU64(Buffer.data() + 16);
+    const uint64_t Blocks = _readU64(Buffer.data() + 24);
+    if (Version != _tableVersion || Interval == 0 ||
+        Blocks != Count / Interval + (Count % Interval != 0) ||
+        Blocks > (Buffer.size() - _headerSize) / 8)
+        return (false);
+
+    // Decode every entry once, so that queries never need to check bounds.
+    const char* Data = Buffer.data() + _headerSize + Blocks * 8;
+    const char* End = Buffer.data() + Buffer.size();
+    const char* Ptr = Data;
+    size_t PrevLen = 0;
+    for (uint64_t i = 0; i < Count; ++i)
+    {
+        uint64_t Shared;
+        uint64_t Rest;
+
+        if (i % Interval == 0 && _readU64(Buffer.data() + _headerSize +
+            (i / Interval) * 8) != uint64_t(Ptr - Data))
+            return (false);
+        if (!_readVarintChecked(Ptr, End, Shared) ||
+            !_readVarintChecked(Ptr, End, Rest) ||
+            (i % Interval == 0 && Shared != 0) || Shared > PrevLen ||
+            Rest > uint64_t(End - Ptr))
+            return (false);
+        Ptr += Rest;
+        PrevLen = Shared + Rest;
+    }
+    if (Ptr != End)
+        return (false);
+
+    _buffer.swap(Buffer);
+    _count = Count;
+    _interval = Interval;
+    _blocks = Blocks;
+    return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const std::vector<char>& TFrontCodedTable::Buffer(void) const
+{
+    return (_buffer);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t TFrontCodedTable::Size(void) const
+{
+    return (_count);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString TFrontCodedTable::Get(sizeType Index) const
+{
+    TString Result;
+
+    if (Index >= _count)
+        return (Result);
+
+    const char* Ptr = _block(Index / _interval);
+    std::string Entry;
+    for (sizeType i = 0; i <= Index % _interval; ++i)
+        _decode(Ptr, Entry);
+    Result.Append(Entry.data(), Entry.size());
+    return (Result);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<TString> TFrontCodedTable::GetRange(sizeType First,
+    sizeType Last) const
+{
+    std::vector<TString> Entries;
+
+    if (Last > _count)
+        Last = _count;
+    if (First >= Last)
+        return (Entries);
+    Entries.reserve(Last - First);
+
+    const char* Ptr = _block(First / _interval);
+    std::string Entry;
+    for (sizeType i = First - First % _interval; i < Last; ++i)
+    {
+        _decode(Ptr, Entry);
+        if (i < First)
+            continue;
+        Entries.emplace_back();
+        Entries.back().Append(Entry.data(), Entry.size());
+    }
+    return (Entries);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+sizeType TFrontCodedTable::LowerBound(const TString& Key) const
+{
+    return (_lowerBound(Key.CStr(), Key.Length()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::pair<sizeType, sizeType> TFrontCodedTable::PrefixRange(
+    const TString& Prefix) const
+{
+    const sizeType First = _lowerBound(Prefix.CStr(), Prefix.Length());
+
+    // The entries with the prefix end before the smallest string greater
+    // than all of them: the prefix without its trailing 0xFF bytes, with its
+    // last byte incremented.
+    std::string Upper(Prefix.CStr() ? Prefix.CStr() : "", Prefix.Length());
+    while (!Upper.empty() && static_cast<unsigned char>(Upper.back()) == 0xFF)
+        Upper.pop_back();
+    if (Upper.empty())
+        return (std::make_pair(First, _count));
+    Upper.back() = static_cast<char>(
+        static_cast<unsigned char>(Upper.back()) + 1);
+    return (std::make_pair(First, _lowerBound(Upper.data(), Upper.size())));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+sizeType TFrontCodedTable::_lowerBound(const char* Key, size_t Len) const
+{
+    // Restart points are stored in full and compared in place.
+    sizeType Low = 0;
+    sizeType High = _blocks;
+    while (Low < High)
+    {
+        const sizeType Mid = Low + (High - Low) / 2;
+        const char* Ptr = _block(Mid);
+        _readVarint(Ptr);
+        const size_t RestartLen = _readVarint(Ptr);
+        if (_less(Ptr, RestartLen, Key, Len))
+            Low = Mid + 1;
+        else
+            High = Mid;
+    }
+    if (Low == 0)
+        return (0);
+
+    // The restart point of the previous block is lower than the key: the
+    // answer is in that block, or is the restart point found.
+    const sizeType Block = Low - 1;
+    const sizeType End = std::min(Block * _interval + _interval, _count);
+    const char* Ptr = _block(Block);
+    std::string Entry;
+    _decode(Ptr, Entry);
+    for (sizeType i = Block * _interval + 1; i < End; ++i)
+    {
+        _decode(Ptr, Entry);
+        if (!_less(Entry.data(), Entry.size(), Key, Len))
+            return (i);
+    }
+    return (End);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const char* TFrontCodedTable::_block(sizeType Block) const
+{
+    const char* Restarts = _buffer.data() + _headerSize;
+    return (Restarts + _blocks * 8 + _readU64(Restarts + Block * 8));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TFrontCodedTable::_decode(const char*& Ptr, std::string& Entry)
+{
+    const size_t Shared = _readVarint(Ptr);
+    const size_t Rest = _readVarint(Ptr);
+
+    Entry.resize(Shared);
+    Entry.append(Ptr, Rest);
+    Ptr += Rest;
+}
+
+} // namespace Ax
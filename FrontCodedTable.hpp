@@ -0,0 +1,201 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Pragma once
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "String.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Immutable sorted string table with front coding.
+///
+/// Every entry is stored as the length of the prefix it shares with the
+/// previous entry followed by the rest of its bytes. Every `Interval`-th
+/// entry is a restart point stored in full, so that lookups binary search
+/// the restart points and then decode at most one block. The whole table
+/// lives in one flat buffer (header, restart offsets, entries), which is
+/// also its serialized form.
+///
+///////////////////////////////////////////////////////////////////////////////
+class TFrontCodedTable
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    using sizeType = size_t;        //<! Type alias for size type.
+    static const size_t npos = -1;  //<! The largest possible value.
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs an empty table.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TFrontCodedTable(void);
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces the content of the table.
+    ///
+    /// \param Sorted The entries, sorted in byte order; duplicates are kept.
+    /// \param Interval Number of entries per restart point, at least 1.
+    ///
+    /// \return False, leaving the table unchanged, if the entries are not
+    /// sorted or `Interval` is 0.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool Build(const std::vector<TString>& Sorted, size_t Interval = 16);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces the content of the table with a serialized one.
+    ///
+    /// \param Buffer A buffer obtained from `Buffer`.
+    ///
+    /// \return False, leaving the table unchanged, if the buffer is not a
+    /// valid table.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool FromBuffer(std::vector<char> Buffer);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the flat buffer holding the table.
+    ///
+    /// \return The buffer, to be stored as is and passed to `FromBuffer`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    const std::vector<char>& Buffer(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the number of entries.
+    ///
+    /// \return The number of entries.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    size_t Size(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes an entry.
+    ///
+    /// \param Index The index of the entry, lower than `Size()`.
+    ///
+    /// \return The entry.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString Get(sizeType Index) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes a range of consecutive entries.
+    ///
+    /// \param First Index of the first entry.
+    /// \param Last Index one past the last entry, at most `Size()`.
+    ///
+    /// \return The entries.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<TString> GetRange(sizeType First, sizeType Last) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the first entry not lower than a key.
+    ///
+    /// \param Key The key.
+    ///
+    /// \return The index of the entry, `Size()` if every entry is lower.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType LowerBound(const TString& Key) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the entries starting with a prefix.
+    ///
+    /// \param Prefix The prefix.
+    ///
+    /// \return The index of the first such entry and the index one past the
+    /// last; both are equal when there is none.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::pair<sizeType, sizeType> PrefixRange(const TString& Prefix) const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the first entry not lower than a key.
+    ///
+    /// \param Key First byte of the key.
+    /// \param Len Length of the key.
+    ///
+    /// \return The index of the entry, `Size()` if every entry is lower.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType _lowerBound(const char* Key, size_t Len) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Locates the first entry of a block.
+    ///
+    /// \param Block The index of the block.
+    ///
+    /// \return A pointer to the encoded entry.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    const char* _block(sizeType Block) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes the entry at `Ptr` on top of the previous entry.
+    ///
+    /// \param Ptr The encoded entry, moved past it.
+    /// \param Entry The previous entry, replaced by the decoded one.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static void _decode(const char*& Ptr, std::string& Entry);
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Private member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<char> _buffer;      //<! Header, restart offsets and entries.
+    size_t _count = 0;              //<! Number of entries.
+    size_t _interval = 1;           //<! Entries per restart point.
+    size_t _blocks = 0;             //<! Number of restart points.
+};
+
+} // namespace Ax
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Export to global namespace.
+///
+///////////////////////////////////////////////////////////////////////////////
+typedef Ax::TFrontCodedTable FFrontCodedTable;
@@ -0,0 +1,284 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Glob.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// Namespace Ax
+///////////////////////////////////////////////////////////////////////////////
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+using sizeType = size_t;
+
+///////////////////////////////////////////////////////////////////////////////
+TGlob::TGlob(void)
+{}
+
+///////////////////////////////////////////////////////////////////////////////
+TGlob::TGlob(const TString& Pattern)
+{
+    Compile(Pattern);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TGlob::Compile(const TString& Pattern)
+{
+    const char* Source = Pattern.CStr();
+    const size_t Len = Pattern.Length();
+    Segment Current;
+
+    _pattern = Pattern;
+    _segments.clear();
+    _hasStar = false;
+    _anchorStart = true;
+    _anchorEnd = true;
+    _minLength = 0;
+
+    auto Flush = [&](void)
+    {
+        if (Current.Length == 0)
+            return;
+        if (!Current.IsLiteral && Current.Length <= 64)
+        {
+            Current.Masks.assign(256, 0);
+            for (sizeType i = 0; i < Current.Length; ++i)
+            {
+                for (unsigned Ch = 0; Ch < 256; ++Ch)
+                {
+                    if ((Current.Sets[i][Ch >> 6] >> (Ch & 63)) & 1)
+                        Current.Masks[Ch] |= uint64_t(1) << i;
+                }
+            }
+        }
+        _minLength += Current.Length;
+        _segments.push_back(std::move(Current));
+        Current = Segment();
+    };
+
+    for (sizeType i = 0; i < Len; ++i)
+    {
+        std::array<uint64_t, 4> Set = {};
+        unsigned char Ch = static_cast<unsigned char>(Source[i]);
+        bool Single = true;
+
+        if (Ch == '*')
+        {
+            _hasStar = true;
+            _anchorStart = _anchorStart && i != 0;
+            _anchorEnd = i + 1 != Len;
+            Flush();
+            continue;
+        }
+        if (Ch == '?')
+        {
+            Set.fill(~uint64_t(0));
+            Single = false;
+        }
+        else if (Ch == '[')
+        {
+            sizeType j = i + 1;
+            bool Negate = false;
+
+            if (j < Len && (Source[j] == '!' || Source[j] == '^'))
+            {
+                Negate = true;
+                ++j;
+            }
+            for (sizeType First = j; j < Len && (Source[j] != ']' ||
+                j == First); ++j)
+            {
+                unsigned Low = static_cast<unsigned char>(Source[j]);
+                unsigned High = Low;
+
+                if (Low == '\\' && j + 1 < Len)
+                    Low = High = static_cast<unsigned char>(Source[++j]);
+                if (j + 2 < Len && Source[j + 1] == '-' && Source[j + 2] != ']')
+                {
+                    j += 2;
+                    if (Source[j] == '\\' && j + 1 < Len)
+                        ++j;
+                    High = static_cast<unsigned char>(Source[j]);
+                }
+                for (unsigned c = Low; c <= High; ++c)
+                    Set[c >> 6] |= uint64_t(1) << (c & 63);
+            }
+            if (j < Len)
+            {
+                if (Negate)
+                {
+                    for (uint64_t& Word : Set)
+                        Word = ~Word;
+                }
+                Single = false;
+                i = j;
+            }
+            else
+                Set = {};
+        }
+        else if (Ch == '\\' && i + 1 < Len)
+            Ch = static_cast<unsigned char>(Source[++i]);
+
+        if (Single)
+        {
+            Set[Ch >> 6] |= uint64_t(1) << (Ch & 63);
+            Current.Literal.PushBack(static_cast<char>(Ch));
+        }
+        else
+            Current.IsLiteral = false;
+        Current.Sets.push_back(Set);
+        Current.Length++;
+    }
+    Flush();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TGlob::Match(const TString& Str) const
+{
+    const size_t Len = Str.Length();
+    const char* Subject = Str.CStr();
+    size_t First = 0;
+    size_t Last = _segments.size();
+    sizeType Pos = 0;
+    sizeType End = Len;
+
+    if (Len < _minLength)
+        return (false);
+    if (!_hasStar)
+    {
+        return (Len == _minLength &&
+            (_segments.empty() || _matchAt(_segments[0], Subject, 0)));
+    }
+    if (_anchorStart)
+    {
+        if (!_matchAt(_segments[0], Subject, 0))
+            return (false);
+        Pos = _segments[0].Length;
+        First = 1;
+    }
+    if (_anchorEnd)
+    {
+        const Segment& Tail = _segments[Last - 1];
+        if (!_matchAt(Tail, Subject, Len - Tail.Length))
+            return (false);
+        End = Len - Tail.Length;
+        --Last;
+    }
+    for (size_t i = First; i < Last; ++i)
+    {
+        const sizeType At = _find(_segments[i], Str, Pos, End);
+        if (At == npos)
+            return (false);
+        Pos = At + _segments[i].Length;
+    }
+    return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const TString& TGlob::Pattern(void) const
+{
+    return (_pattern);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<sizeType> TGlob::MatchAll(const TString& Str,
+    const std::vector<TGlob>& Globs)
+{
+    std::vector<sizeType> Matched;
+
+    for (sizeType i = 0; i < Globs.size(); ++i)
+    {
+        if (Globs[i].Match(Str))
+            Matched.push_back(i);
+    }
+    return (Matched);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+sizeType TGlob::MatchFirst(const TString& Str, const std::vector<TGlob>& Globs)
+{
+    for (sizeType i = 0; i < Globs.size(); ++i)
+    {
+        if (Globs[i].Match(Str))
+            return (i);
+    }
+    return (npos);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TGlob::_matchAt(const Segment& Seg, const char* Str, sizeType At)
+{
+    if (Seg.IsLiteral)
+        return (::memcmp(Str + At, Seg.Literal.CStr(), Seg.Length) == 0);
+    for (sizeType i = 0; i < Seg.Length; ++i)
+    {
+        const unsigned char Ch = static_cast<unsigned char>(Str[At + i]);
+        if (!((Seg.Sets[i][Ch >> 6] >> (Ch & 63)) & 1))
+            return (false);
+    }
+    return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+sizeType TGlob::_find(const Segment& Seg, const TString& Str, sizeType Pos,
+    sizeType End)
+{
+    if (End < Pos || End - Pos < Seg.Length)
+        return (npos);
+    if (Seg.IsLiteral)
+    {
+        const sizeType At = Str.Find(Seg.Literal, Pos);
+        return (At != npos && At + Seg.Length <= End ? At : npos);
+    }
+
+    const char* Subject = Str.CStr();
+    if (!Seg.Masks.empty())
+    {
+        const uint64_t Accept = uint64_t(1) << (Seg.Length - 1);
+        uint64_t State = 0;
+
+        for (sizeType i = Pos; i < End; ++i)
+        {
+            State = ((State << 1) | 1) &
+                Seg.Masks[static_cast<unsigned char>(Subject[i])];
+            if (State & Accept)
+                return (i + 1 - Seg.Length);
+        }
+        return (npos);
+    }
+    for (sizeType i = Pos; i + Seg.Length <= End; ++i)
+    {
+        if (_matchAt(Seg, Subject, i))
+            return (i);
+    }
+    return (npos);
+}
+
+} // namespace Ax
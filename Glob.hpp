@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Pragma once
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "String.hpp"
+#include <vector>
+#include <array>
+#include <cstdint>
+
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Compiled wildcard pattern.
+///
+/// Supports `*` (any sequence, including an empty one), `?` (any single
+/// character), `[abc]`, `[a-z]` and their negations `[!...]` / `[^...]`, and
+/// `\` to escape the next character. The pattern is split once on its stars
+/// into fixed-width segments; matching then places every segment at its
+/// leftmost possible position, which never needs to backtrack and visits
+/// each character of the subject a bounded number of times. Segments made of
+/// plain characters are located with `TString::Find`, the others with a
+/// bit-parallel Shift-And scan.
+///
+///////////////////////////////////////////////////////////////////////////////
+class TGlob
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    using sizeType = size_t;        //<! Type alias for size type.
+    static const size_t npos = -1;  //<! The largest possible value.
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs a pattern matching only the empty string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TGlob(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs and compiles a pattern.
+    ///
+    /// \param Pattern The wildcard pattern.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TGlob(const TString& Pattern);
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces the pattern with a new one.
+    ///
+    /// An unterminated `[` is taken literally, as is a trailing `\`.
+    ///
+    /// \param Pattern The wildcard pattern.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Compile(const TString& Pattern);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Tells whether a string matches the whole pattern.
+    ///
+    /// \param Str The string to test.
+    ///
+    /// \return True if the pattern matches the entire string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool Match(const TString& Str) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the source of the compiled pattern.
+    ///
+    /// \return The pattern.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    const TString& Pattern(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Tests one string against many compiled patterns.
+    ///
+    /// \param Str The string to test.
+    /// \param Globs The patterns.
+    ///
+    /// \return The indices of the matching patterns, in increasing order.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static std::vector<sizeType> MatchAll(const TString& Str,
+        const std::vector<TGlob>& Globs);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the first of many compiled patterns matching a string.
+    ///
+    /// \param Str The string to test.
+    /// \param Globs The patterns, in priority order.
+    ///
+    /// \return The index of the first matching pattern, or `npos`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static sizeType MatchFirst(const TString& Str,
+        const std::vector<TGlob>& Globs);
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A run of fixed-width pattern elements between two stars.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    struct Segment
+    {
+        size_t Length = 0;      //<! Number of characters matched.
+        bool IsLiteral = true;  //<! True if made of plain characters only.
+        TString Literal;        //<! The characters, when literal.
+        std::vector<std::array<uint64_t, 4>> Sets; //<! Accepted bytes.
+        std::vector<uint64_t> Masks; //<! Shift-And masks, up to 64 elements.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Tells whether a segment matches at a given position.
+    ///
+    /// \param Seg The segment.
+    /// \param Str The subject.
+    /// \param At The position, the segment must fit in the subject.
+    ///
+    /// \return True if the segment matches at `At`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static bool _matchAt(const Segment& Seg, const char* Str, sizeType At);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the leftmost occurrence of a segment in a range.
+    ///
+    /// \param Seg The segment.
+    /// \param Str The subject.
+    /// \param Pos First position of the range.
+    /// \param End Position one past the last character of the range.
+    ///
+    /// \return The position of the occurrence, or `npos`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static sizeType _find(const Segment& Seg, const TString& Str, sizeType Pos,
+        sizeType End);
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Private member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString _pattern;               //<! Source of the pattern.
+    std::vector<Segment> _segments; //<! Segments between the stars.
+    bool _hasStar = false;          //<! True if the pattern holds a star.
+    bool _anchorStart = true;       //<! True if it does not start with one.
+    bool _anchorEnd = true;         //<! True if it does not end with one.
+    size_t _minLength = 0;          //<! Shortest length that can match.
+};
+
+} // namespace Ax
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Export to global namespace.
+///
+///////////////////////////////////////////////////////////////////////////////
+typedef Ax::TGlob FGlob;
@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "HashedString.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// Namespace Ax
+///////////////////////////////////////////////////////////////////////////////
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+THashedString::THashedString(void)
+    : _hash(TString::HashBytes(nullptr, 0))
+{}
+
+///////////////////////////////////////////////////////////////////////////////
+THashedString::THashedString(const TString& Str, uint64_t Seed)
+    : _str(Str)
+    , _seed(Seed)
+{
+    _rehash();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+THashedString::THashedString(TString&& Str, uint64_t Seed)
+    : _str(std::move(Str))
+    , _seed(Seed)
+{
+    _rehash();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+THashedString::THashedString(const char* Str, uint64_t Seed)
+    : _str(Str)
+    , _seed(Seed)
+{
+    _rehash();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const TString& THashedString::Str(void) const
+{
+    return (_str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const char* THashedString::CStr(void) const
+{
+    return (_str.CStr());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t THashedString::Length(void) const
+{
+    return (_str.Length());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+uint64_t THashedString::Hash(void) const
+{
+    return (_hash);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+uint64_t THashedString::Seed(void) const
+{
+    return (_seed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void THashedString::Assign(const TString& Str)
+{
+    _str = Str;
+    _rehash();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void THashedString::Assign(TString&& Str)
+{
+    _str = std::move(Str);
+    _rehash();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+THashedString& THashedString::Append(const TString& Str)
+{
+    _str.Append(Str);
+    _rehash();
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+THashedString& THashedString::Append(const char* Str, size_t Len)
+{
+    _str.Append(Str, Len);
+    _rehash();
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void THashedString::Clear(void)
+{
+    _str.Clear();
+    _rehash();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString THashedString::Release(void)
+{
+    TString Content(std::move(_str));
+
+    _str = TString();
+    _rehash();
+    return (Content);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void THashedString::_rehash(void)
+{
+    _hash = _str.Hash(_seed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool operator==(const THashedString& Lhs, const THashedString& Rhs)
+{
+    if (Lhs._seed == Rhs._seed && Lhs._hash != Rhs._hash)
+        return (false);
+    return (Lhs._str == Rhs._str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool operator!=(const THashedString& Lhs, const THashedString& Rhs)
+{
+    return (!(Lhs == Rhs));
+}
+
+} // namespace Ax
@@ -0,0 +1,252 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Pragma once
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "String.hpp"
+#include <cstdint>
+#include <utility>
+
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A string that keeps its hash.
+///
+/// The hash is computed when the content is set and after every change made
+/// through this class, which gives no mutable access to the bytes, so it
+/// can never go stale. Const access only reads, so a shared instance can be
+/// hashed and compared from several threads at once. Equality compares the
+/// hashes first when both sides use the same seed.
+///
+///////////////////////////////////////////////////////////////////////////////
+class THashedString
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs an empty string, hashed with seed 0.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    THashedString(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs from a copy of a string.
+    ///
+    /// \param Str The content.
+    /// \param Seed Seed of the hash, as given to `TString::Hash`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    THashedString(const TString& Str, uint64_t Seed = 0);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs by taking over a string.
+    ///
+    /// \param Str The content.
+    /// \param Seed Seed of the hash, as given to `TString::Hash`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    THashedString(TString&& Str, uint64_t Seed = 0);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs from a C-string.
+    ///
+    /// \param Str The content.
+    /// \param Seed Seed of the hash, as given to `TString::Hash`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    THashedString(const char* Str, uint64_t Seed = 0);
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the content.
+    ///
+    /// \return The string, read-only.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    const TString& Str(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the content as a C-string.
+    ///
+    /// \return A pointer to the first character.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    const char* CStr(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the length of the content.
+    ///
+    /// \return The number of characters.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    size_t Length(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the kept hash.
+    ///
+    /// \return `Str().Hash(Seed())`, without reading the content.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    uint64_t Hash(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the seed of the kept hash.
+    ///
+    /// \return The seed.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    uint64_t Seed(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces the content with a copy of a string.
+    ///
+    /// \param Str The new content.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Assign(const TString& Str);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces the content by taking over a string.
+    ///
+    /// \param Str The new content.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Assign(TString&& Str);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Appends a string and hashes the result.
+    ///
+    /// \param Str The string to append.
+    ///
+    /// \return A reference to this string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    THashedString& Append(const TString& Str);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Appends bytes and hashes the result.
+    ///
+    /// \param Str The bytes to append.
+    /// \param Len Number of bytes.
+    ///
+    /// \return A reference to this string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    THashedString& Append(const char* Str, size_t Len);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Edits the content with any `TString` operation, then hashes
+    /// the result.
+    ///
+    /// \param Func Called with the content as a `TString&`; references it
+    /// hands out must not be kept past the call.
+    ///
+    /// \return A reference to this string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename F>
+    THashedString& Modify(F Func);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Empties the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Clear(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Moves the content out, leaving this string empty.
+    ///
+    /// \return The content.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString Release(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Compares two strings, checking the hashes first when both use
+    /// the same seed.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    friend bool operator==(const THashedString& Lhs, const THashedString& Rhs);
+    friend bool operator!=(const THashedString& Lhs, const THashedString& Rhs);
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Hashes the content again, after every change.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void _rehash(void);
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Private member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString _str;                   //<! The content.
+    uint64_t _seed = 0;             //<! Seed of the hash.
+    uint64_t _hash = 0;             //<! Hash of the content.
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename F>
+THashedString& THashedString::Modify(F Func)
+{
+    Func(_str);
+    _rehash();
+    return (*this);
+}
+
+} // namespace Ax
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Specialization of std::hash, equal to the one of the content so
+/// that it agrees with `operator==` whatever the seeds; the kept hash is
+/// reused when its seed is 0.
+///
+///////////////////////////////////////////////////////////////////////////////
+namespace std
+{
+template <>
+struct hash<Ax::THashedString>
+{
+    size_t operator()(const Ax::THashedString& Str) const noexcept
+    {
+        return (static_cast<size_t>(Str.Seed() == 0 ? Str.Hash()
+            : Str.Str().Hash()));
+    }
+};
+} // namespace std
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Export to global namespace.
+///
+///////////////////////////////////////////////////////////////////////////////
+typedef Ax::THashedString FHashedString;
@@ -28,6 +28,36 @@
 // Headers
 ///////////////////////////////////////////////////////////////////////////////
 #include "String.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <random>
+#include <thread>
+#if defined(__SSE2__)
+    #include <immintrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Runtime dispatch: with GCC or Clang on x86, kernels for instruction sets
+// the build flags do not enable are still compiled, with a target
+// attribute, and only called once the CPU is known to support them.
+///////////////////////////////////////////////////////////////////////////////
+#if defined(__GNUC__) && defined(__SSE2__) && \
+    (defined(__x86_64__) || defined(__i386__))
+    #define AX_CPU_DISPATCH
+    #define AX_TARGET_AVX2 __attribute__((target("avx2")))
+    #define AX_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+    #define AX_TARGET_AVX2
+    #define AX_TARGET_SSSE3
+#endif
+#if defined(__AVX2__) || defined(AX_CPU_DISPATCH)
+    #define AX_AVX2_KERNELS
+#endif
+#if defined(__SSSE3__) || defined(AX_CPU_DISPATCH)
+    #define AX_SSSE3_KERNELS
+#endif
 
 ///////////////////////////////////////////////////////////////////////////////
 // Namespace Ax
@@ -38,750 +68,4109 @@ namespace Ax
 ///////////////////////////////////////////////////////////////////////////////
 using sizeType = size_t;
 
+///////////////////////////////////////////////////////////////////////////////
+// Kernels
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(AX_AVX2_KERNELS)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Tells whether the AVX2 kernels may run on this CPU.
+///
+///////////////////////////////////////////////////////////////////////////////
+static bool _cpuHasAvx2(void)
+{
+#if defined(__AVX2__)
+    return (true);
+#else
+    static const bool Supported = __builtin_cpu_supports("avx2");
+    return (Supported);
+#endif
+}
+#endif
+
+#if defined(AX_SSSE3_KERNELS)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Tells whether the SSSE3 kernels may run on this CPU.
+///
+///////////////////////////////////////////////////////////////////////////////
+static bool _cpuHasSsse3(void)
+{
+#if defined(__SSSE3__)
+    return (true);
+#else
+    static const bool Supported = __builtin_cpu_supports("ssse3");
+    return (Supported);
+#endif
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Finds the first occurrence of a needle in a buffer.
+///
+/// Candidates are filtered on the first and last character of the needle,
+/// 16 or 32 positions per step, and only the survivors are compared in full.
+///
+/// \return A pointer to the occurrence, or null.
+///
+///////////////////////////////////////////////////////////////////////////////
+static const char* _searchBytes(const char* Hay, size_t HayLen,
+    const char* Needle, size_t Len)
+{
+    if (Len == 0)
+        return (Hay);
+    if (Len > HayLen)
+        return (nullptr);
+    if (Len == 1)
+        return (static_cast<const char*>(::memchr(Hay, *Needle, HayLen)));
+
+    const size_t Last = HayLen - Len;
+    sizeType i = 0;
+#if defined(__AVX2__)
+    const __m256i First32 = _mm256_set1_epi8(Needle[0]);
+    const __m256i Last32 = _mm256_set1_epi8(Needle[Len - 1]);
+    for (; i + 32 <= Last + 1; i += 32)
+    {
+        const __m256i A = _mm256_loadu_si256((const __m256i*)(Hay + i));
+        const __m256i B = _mm256_loadu_si256((const __m256i*)(Hay + i + Len - 1));
+        uint32_t Mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(A, First32),
+            _mm256_cmpeq_epi8(B, Last32))));
+        while (Mask)
+        {
+            const sizeType At = i + __builtin_ctz(Mask);
+            if (::memcmp(Hay + At + 1, Needle + 1, Len - 2) == 0)
+                return (Hay + At);
+            Mask &= Mask - 1;
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i First16 = _mm_set1_epi8(Needle[0]);
+    const __m128i Last16 = _mm_set1_epi8(Needle[Len - 1]);
+    for (; i + 16 <= Last + 1; i += 16)
+    {
+        const __m128i A = _mm_loadu_si128((const __m128i*)(Hay + i));
+        const __m128i B = _mm_loadu_si128((const __m128i*)(Hay + i + Len - 1));
+        uint32_t Mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(A, First16),
+            _mm_cmpeq_epi8(B, Last16))));
+        while (Mask)
+        {
+            const sizeType At = i + __builtin_ctz(Mask);
+            if (::memcmp(Hay + At + 1, Needle + 1, Len - 2) == 0)
+                return (Hay + At);
+            Mask &= Mask - 1;
+        }
+    }
+#endif
+    while (i <= Last)
+    {
+        const char* Candidate = static_cast<const char*>(
+            ::memchr(Hay + i, *Needle, Last - i + 1));
+        if (!Candidate)
+            return (nullptr);
+        if (::memcmp(Candidate + 1, Needle + 1, Len - 1) == 0)
+            return (Candidate);
+        i = (Candidate - Hay) + 1;
+    }
+    return (nullptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Counts the occurrences of a character in a buffer.
+///
+/// \return The number of bytes equal to `Ch`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _countByte(const char* Data, size_t Len, char Ch)
+{
+    size_t Count = 0;
+    sizeType i = 0;
+#if defined(__AVX2__)
+    const __m256i Needle32 = _mm256_set1_epi8(Ch);
+    for (; i + 32 <= Len; i += 32)
+    {
+        const __m256i Block = _mm256_loadu_si256((const __m256i*)(Data + i));
+        Count += __builtin_popcount(static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(Block, Needle32))));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i Needle16 = _mm_set1_epi8(Ch);
+    for (; i + 16 <= Len; i += 16)
+    {
+        const __m128i Block = _mm_loadu_si128((const __m128i*)(Data + i));
+        Count += __builtin_popcount(static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(Block, Needle16))));
+    }
+#endif
+    for (; i < Len; ++i)
+        Count += (Data[i] == Ch);
+    return (Count);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Folds an ASCII upper case letter to lower case, every other byte
+/// is returned unchanged.
+///
+///////////////////////////////////////////////////////////////////////////////
+static inline unsigned char _foldAscii(unsigned char Ch)
+{
+    const bool Upper = static_cast<unsigned>(Ch - 'A') < 26u;
+
+    return (static_cast<unsigned char>(Ch + (Upper << 5)));
+}
+
+#if defined(__SSE2__)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Folds the ASCII upper case letters of a block to lower case.
+///
+///////////////////////////////////////////////////////////////////////////////
+static inline __m128i _foldAscii(__m128i Block)
+{
+    const __m128i Upper = _mm_and_si128(
+        _mm_cmpgt_epi8(Block, _mm_set1_epi8('A' - 1)),
+        _mm_cmplt_epi8(Block, _mm_set1_epi8('Z' + 1)));
+    return (_mm_or_si128(Block, _mm_and_si128(Upper, _mm_set1_epi8(0x20))));
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Flips the case of the ASCII letters from `First` to `First + 25`.
+///
+/// `Src` and `Dst` may be the same buffer. Bytes above 0x7F are copied
+/// unchanged; they compare lower than any letter as signed bytes.
+///
+/// \return True if a byte above 0x7F was seen.
+///
+///////////////////////////////////////////////////////////////////////////////
+static bool _asciiCase(const char* Src, char* Dst, size_t Len, char First)
+{
+    size_t i = 0;
+    bool NonAscii = false;
+
+#if defined(__AVX2__)
+    const __m256i Low32 = _mm256_set1_epi8(First - 1);
+    const __m256i High32 = _mm256_set1_epi8(First + 26);
+    const __m256i Flip32 = _mm256_set1_epi8(0x20);
+    __m256i Seen32 = _mm256_setzero_si256();
+    for (; i + 32 <= Len; i += 32)
+    {
+        const __m256i Block = _mm256_loadu_si256((const __m256i*)(Src + i));
+        const __m256i Letter = _mm256_and_si256(
+            _mm256_cmpgt_epi8(Block, Low32), _mm256_cmpgt_epi8(High32, Block));
+        _mm256_storeu_si256((__m256i*)(Dst + i), _mm256_xor_si256(Block,
+            _mm256_and_si256(Letter, Flip32)));
+        Seen32 = _mm256_or_si256(Seen32, Block);
+    }
+    NonAscii = _mm256_movemask_epi8(Seen32) != 0;
+#endif
+#if defined(__SSE2__)
+    const __m128i Low = _mm_set1_epi8(First - 1);
+    const __m128i High = _mm_set1_epi8(First + 26);
+    const __m128i Flip = _mm_set1_epi8(0x20);
+    __m128i Seen = _mm_setzero_si128();
+    for (; i + 16 <= Len; i += 16)
+    {
+        const __m128i Block = _mm_loadu_si128((const __m128i*)(Src + i));
+        const __m128i Letter = _mm_and_si128(_mm_cmpgt_epi8(Block, Low),
+            _mm_cmpgt_epi8(High, Block));
+        _mm_storeu_si128((__m128i*)(Dst + i), _mm_xor_si128(Block,
+            _mm_and_si128(Letter, Flip)));
+        Seen = _mm_or_si128(Seen, Block);
+    }
+    NonAscii = NonAscii || _mm_movemask_epi8(Seen) != 0;
+#endif
+    for (; i < Len; ++i)
+    {
+        const unsigned char Ch = static_cast<unsigned char>(Src[i]);
+        NonAscii = NonAscii || Ch > 0x7F;
+        Dst[i] = static_cast<char>(
+            static_cast<unsigned>(Ch - First) < 26u ? Ch ^ 0x20 : Ch);
+    }
+    return (NonAscii);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Converts the bytes above 0x7F with the C library, which maps them
+/// according to the current locale (single-byte encodings only; UTF-8
+/// sequences are left as they are).
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _localeCase(char* Data, size_t Len, bool Upper)
+{
+    for (size_t i = 0; i < Len; ++i)
+    {
+        const unsigned char Ch = static_cast<unsigned char>(Data[i]);
+        if (Ch > 0x7F)
+            Data[i] = static_cast<char>(Upper ? ::toupper(Ch) : ::tolower(Ch));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Tells whether a byte is ASCII whitespace.
+///
+///////////////////////////////////////////////////////////////////////////////
+static inline bool _isSpace(unsigned char Ch)
+{
+    return (Ch == ' ' || static_cast<unsigned>(Ch - '\t') < 5u);
+}
+
+#if defined(__SSE2__)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Finds the ASCII whitespace bytes of a block.
+///
+/// \return A mask with bit `i` set when byte `i` is whitespace.
+///
+///////////////////////////////////////////////////////////////////////////////
+static inline unsigned _spaceMask(__m128i Block)
+{
+    const __m128i Space = _mm_or_si128(
+        _mm_cmpeq_epi8(Block, _mm_set1_epi8(' ')),
+        _mm_and_si128(_mm_cmpgt_epi8(Block, _mm_set1_epi8('\t' - 1)),
+            _mm_cmplt_epi8(Block, _mm_set1_epi8('\r' + 1))));
+    return (static_cast<unsigned>(_mm_movemask_epi8(Space)));
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Counts the leading ASCII whitespace bytes.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _skipSpace(const char* Data, size_t Len)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 16 <= Len; i += 16)
+    {
+        const unsigned Other = ~_spaceMask(
+            _mm_loadu_si128((const __m128i*)(Data + i))) & 0xFFFF;
+        if (Other)
+            return (i + __builtin_ctz(Other));
+    }
+#endif
+    while (i < Len && _isSpace(static_cast<unsigned char>(Data[i])))
+        i++;
+    return (i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Finds the length left once the trailing ASCII whitespace bytes are
+/// removed.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _skipSpaceBack(const char* Data, size_t Len)
+{
+#if defined(__SSE2__)
+    for (; Len >= 16; Len -= 16)
+    {
+        const unsigned Other = ~_spaceMask(
+            _mm_loadu_si128((const __m128i*)(Data + Len - 16))) & 0xFFFF;
+        if (Other)
+            return (Len - 16 + (31 - __builtin_clz(Other)) + 1);
+    }
+#endif
+    while (Len > 0 && _isSpace(static_cast<unsigned char>(Data[Len - 1])))
+        Len--;
+    return (Len);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Measures the UTF-8 sequence starting at a position.
+///
+/// Follows table 3-7 of the Unicode standard: no overlong forms, no
+/// surrogates, nothing above U+10FFFF.
+///
+/// \return The length of the sequence, or 0 if it is invalid or truncated.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _utf8Sequence(const unsigned char* Str, size_t Len, size_t Pos)
+{
+    const unsigned char Lead = Str[Pos];
+    size_t Need = 0;
+    unsigned char Low = 0x80;
+    unsigned char High = 0xBF;
+
+    if (Lead < 0x80)
+        return (1);
+    else if (Lead >= 0xC2 && Lead <= 0xDF)
+        Need = 1;
+    else if (Lead >= 0xE0 && Lead <= 0xEF)
+    {
+        Need = 2;
+        Low = Lead == 0xE0 ? 0xA0 : 0x80;
+        High = Lead == 0xED ? 0x9F : 0xBF;
+    }
+    else if (Lead >= 0xF0 && Lead <= 0xF4)
+    {
+        Need = 3;
+        Low = Lead == 0xF0 ? 0x90 : 0x80;
+        High = Lead == 0xF4 ? 0x8F : 0xBF;
+    }
+    else
+        return (0);
+    if (Len - Pos <= Need || Str[Pos + 1] < Low || Str[Pos + 1] > High)
+        return (0);
+    for (size_t k = 2; k <= Need; ++k)
+    {
+        if ((Str[Pos + k] & 0xC0) != 0x80)
+            return (0);
+    }
+    return (Need + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Decodes the UTF-8 sequence starting at a position.
+///
+/// \param Pos Position of the sequence, moved past it. An invalid sequence
+/// decodes to U+FFFD and only its first byte is skipped.
+///
+/// \return The code point.
+///
+///////////////////////////////////////////////////////////////////////////////
+static char32_t _decodeUtf8(const char* Data, size_t Len, size_t& Pos)
+{
+    const unsigned char* Str = reinterpret_cast<const unsigned char*>(Data);
+    const size_t Size = _utf8Sequence(Str, Len, Pos);
+    char32_t Code = Str[Pos];
+
+    if (Size == 0)
+    {
+        Pos++;
+        return (0xFFFD);
+    }
+    if (Size > 1)
+    {
+        Code &= 0x7F >> Size;
+        for (size_t k = 1; k < Size; ++k)
+            Code = (Code << 6) | (Str[Pos + k] & 0x3F);
+    }
+    Pos += Size;
+    return (Code);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Encodes a code point as UTF-8.
+///
+/// \param Code A valid code point.
+/// \param Dst Receives up to 4 bytes.
+///
+/// \return The number of bytes written.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _encodeUtf8(char32_t Code, char* Dst)
+{
+    if (Code < 0x80)
+    {
+        Dst[0] = static_cast<char>(Code);
+        return (1);
+    }
+    if (Code < 0x800)
+    {
+        Dst[0] = static_cast<char>(0xC0 | (Code >> 6));
+        Dst[1] = static_cast<char>(0x80 | (Code & 0x3F));
+        return (2);
+    }
+    if (Code < 0x10000)
+    {
+        Dst[0] = static_cast<char>(0xE0 | (Code >> 12));
+        Dst[1] = static_cast<char>(0x80 | ((Code >> 6) & 0x3F));
+        Dst[2] = static_cast<char>(0x80 | (Code & 0x3F));
+        return (3);
+    }
+    Dst[0] = static_cast<char>(0xF0 | (Code >> 18));
+    Dst[1] = static_cast<char>(0x80 | ((Code >> 12) & 0x3F));
+    Dst[2] = static_cast<char>(0x80 | ((Code >> 6) & 0x3F));
+    Dst[3] = static_cast<char>(0x80 | (Code & 0x3F));
+    return (4);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Finds the first invalid UTF-8 sequence, one code point at a time.
+///
+/// \param Pos Position to start from, which must start a sequence.
+///
+/// \return The offset of the first byte of the first invalid or truncated
+/// sequence, or `Len` if there is none.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _utf8Scalar(const char* Data, size_t Len, size_t Pos)
+{
+    const unsigned char* Str = reinterpret_cast<const unsigned char*>(Data);
+
+    while (Pos < Len)
+    {
+        if (Pos + 8 <= Len)
+        {
+            uint64_t Block;
+            ::memcpy(&Block, Str + Pos, 8);
+            if (!(Block & 0x8080808080808080ull))
+            {
+                Pos += 8;
+                continue;
+            }
+        }
+
+        const size_t Size = _utf8Sequence(Str, Len, Pos);
+        if (Size == 0)
+            return (Pos);
+        Pos += Size;
+    }
+    return (Len);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Error classes of the lookup validator; a pair of bytes is invalid
+/// when the classes looked up from the high and low nibbles of the first
+/// byte and the high nibble of the second have a bit in common.
+///
+///////////////////////////////////////////////////////////////////////////////
+enum : unsigned char
+{
+    _utf8TooShort = 1 << 0,     //<! Lead not followed by a continuation.
+    _utf8TooLong = 1 << 1,      //<! Continuation after an ASCII byte.
+    _utf8Overlong3 = 1 << 2,    //<! 11100000 100_____
+    _utf8TooLarge = 1 << 3,     //<! Above U+10FFFF, 1001____ or 101_____.
+    _utf8Surrogate = 1 << 4,    //<! 11101101 101_____
+    _utf8Overlong2 = 1 << 5,    //<! 1100000_ 10______
+    _utf8TooLarge1000 = 1 << 6, //<! Above U+10FFFF, 1000____.
+    _utf8Overlong4 = 1 << 6,    //<! 11110000 1000____
+    _utf8TwoConts = 1 << 7,     //<! Continuation after a continuation.
+    _utf8Carry = _utf8TooShort | _utf8TooLong | _utf8TwoConts
+};
+
+#if defined(AX_SSSE3_KERNELS)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Lookup tables of the validator, indexed by a nibble.
+///
+///////////////////////////////////////////////////////////////////////////////
+AX_TARGET_SSSE3 static inline __m128i _utf8Byte1High(void)
+{
+    return (_mm_setr_epi8(
+        _utf8TooLong, _utf8TooLong, _utf8TooLong, _utf8TooLong,
+        _utf8TooLong, _utf8TooLong, _utf8TooLong, _utf8TooLong,
+        (char)_utf8TwoConts, (char)_utf8TwoConts, (char)_utf8TwoConts,
+        (char)_utf8TwoConts,
+        _utf8TooShort | _utf8Overlong2,
+        _utf8TooShort,
+        _utf8TooShort | _utf8Overlong3 | _utf8Surrogate,
+        _utf8TooShort | _utf8TooLarge | _utf8TooLarge1000 | _utf8Overlong4));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+AX_TARGET_SSSE3 static inline __m128i _utf8Byte1Low(void)
+{
+    const char Large = (char)(_utf8Carry | _utf8TooLarge | _utf8TooLarge1000);
+
+    return (_mm_setr_epi8(
+        (char)(_utf8Carry | _utf8Overlong3 | _utf8Overlong2 | _utf8Overlong4),
+        (char)(_utf8Carry | _utf8Overlong2),
+        (char)_utf8Carry, (char)_utf8Carry,
+        (char)(_utf8Carry | _utf8TooLarge),
+        Large, Large, Large, Large, Large, Large, Large, Large,
+        (char)(Large | _utf8Surrogate), Large, Large));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+AX_TARGET_SSSE3 static inline __m128i _utf8Byte2High(void)
+{
+    return (_mm_setr_epi8(
+        _utf8TooShort, _utf8TooShort, _utf8TooShort, _utf8TooShort,
+        _utf8TooShort, _utf8TooShort, _utf8TooShort, _utf8TooShort,
+        _utf8TooLong | _utf8Overlong2 | (char)_utf8TwoConts | _utf8Overlong3 |
+            _utf8TooLarge1000 | _utf8Overlong4,
+        _utf8TooLong | _utf8Overlong2 | (char)_utf8TwoConts | _utf8Overlong3 |
+            _utf8TooLarge,
+        _utf8TooLong | _utf8Overlong2 | (char)_utf8TwoConts | _utf8Surrogate |
+            _utf8TooLarge,
+        _utf8TooLong | _utf8Overlong2 | (char)_utf8TwoConts | _utf8Surrogate |
+            _utf8TooLarge,
+        _utf8TooShort, _utf8TooShort, _utf8TooShort, _utf8TooShort));
+}
+#endif
+
+#if defined(AX_AVX2_KERNELS)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Validates the byte pairs of a 32-byte block (Keiser-Lemire).
+///
+/// \param Input The block.
+/// \param Prev The previous block, or zeros.
+///
+/// \return Non-zero bytes where a sequence is invalid.
+///
+///////////////////////////////////////////////////////////////////////////////
+AX_TARGET_AVX2 static inline __m256i _utf8Block(__m256i Input,
+    __m256i Prev)
+{
+    const __m256i Nibble = _mm256_set1_epi8(0x0F);
+    const __m256i Carried = _mm256_permute2x128_si256(Prev, Input, 0x21);
+    const __m256i Prev1 = _mm256_alignr_epi8(Input, Carried, 15);
+    const __m256i Prev2 = _mm256_alignr_epi8(Input, Carried, 14);
+    const __m256i Prev3 = _mm256_alignr_epi8(Input, Carried, 13);
+    const __m256i Special = _mm256_and_si256(_mm256_and_si256(
+        _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_utf8Byte1High()),
+            _mm256_and_si256(_mm256_srli_epi16(Prev1, 4), Nibble)),
+        _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_utf8Byte1Low()),
+            _mm256_and_si256(Prev1, Nibble))),
+        _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_utf8Byte2High()),
+            _mm256_and_si256(_mm256_srli_epi16(Input, 4), Nibble)));
+
+    // Third and fourth bytes of a sequence must be continuations, which the
+    // pair lookup above cannot see.
+    const __m256i Must23 = _mm256_and_si256(_mm256_or_si256(
+        _mm256_subs_epu8(Prev2, _mm256_set1_epi8(char(0xE0 - 0x80))),
+        _mm256_subs_epu8(Prev3, _mm256_set1_epi8(char(0xF0 - 0x80)))),
+        _mm256_set1_epi8(char(0x80)));
+    return (_mm256_xor_si256(Must23, Special));
+}
+#endif
+
+#if defined(AX_SSSE3_KERNELS)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Validates the byte pairs of a 16-byte block (Keiser-Lemire).
+///
+/// \param Input The block.
+/// \param Prev The previous block, or zeros.
+///
+/// \return Non-zero bytes where a sequence is invalid.
+///
+///////////////////////////////////////////////////////////////////////////////
+AX_TARGET_SSSE3 static inline __m128i _utf8Block(__m128i Input,
+    __m128i Prev)
+{
+    const __m128i Nibble = _mm_set1_epi8(0x0F);
+    const __m128i Prev1 = _mm_alignr_epi8(Input, Prev, 15);
+    const __m128i Prev2 = _mm_alignr_epi8(Input, Prev, 14);
+    const __m128i Prev3 = _mm_alignr_epi8(Input, Prev, 13);
+    const __m128i Special = _mm_and_si128(_mm_and_si128(
+        _mm_shuffle_epi8(_utf8Byte1High(),
+            _mm_and_si128(_mm_srli_epi16(Prev1, 4), Nibble)),
+        _mm_shuffle_epi8(_utf8Byte1Low(), _mm_and_si128(Prev1, Nibble))),
+        _mm_shuffle_epi8(_utf8Byte2High(),
+            _mm_and_si128(_mm_srli_epi16(Input, 4), Nibble)));
+
+    // Third and fourth bytes of a sequence must be continuations, which the
+    // pair lookup above cannot see.
+    const __m128i Must23 = _mm_and_si128(_mm_or_si128(
+        _mm_subs_epu8(Prev2, _mm_set1_epi8(char(0xE0 - 0x80))),
+        _mm_subs_epu8(Prev3, _mm_set1_epi8(char(0xF0 - 0x80)))),
+        _mm_set1_epi8(char(0x80)));
+    return (_mm_xor_si128(Must23, Special));
+}
+#endif
+
+#if defined(AX_AVX2_KERNELS)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief `_utf8VectorPrefix` with AVX2.
+///
+///////////////////////////////////////////////////////////////////////////////
+AX_TARGET_AVX2 static size_t _utf8PrefixAvx2(const char* Data, size_t Len)
+{
+    size_t i = 0;
+
+    // The last three bytes of a block must not start a sequence that needs
+    // more bytes than are left.
+    const __m256i Max = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+    __m256i Prev = _mm256_setzero_si256();
+    __m256i Incomplete = _mm256_setzero_si256();
+    for (; i + 64 <= Len; i += 64)
+    {
+        const __m256i A = _mm256_loadu_si256((const __m256i*)(Data + i));
+        const __m256i B = _mm256_loadu_si256((const __m256i*)(Data + i + 32));
+        __m256i Error = Incomplete;
+        if (_mm256_movemask_epi8(_mm256_or_si256(A, B)))
+        {
+            Error = _mm256_or_si256(_utf8Block(A, Prev), _utf8Block(B, A));
+            Incomplete = _mm256_subs_epu8(B, Max);
+            Prev = B;
+        }
+        if (!_mm256_testz_si256(Error, Error))
+            break;
+    }
+    return (i);
+}
+#endif
+
+#if defined(AX_SSSE3_KERNELS)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief `_utf8VectorPrefix` with SSSE3.
+///
+///////////////////////////////////////////////////////////////////////////////
+AX_TARGET_SSSE3 static size_t _utf8PrefixSsse3(const char* Data, size_t Len)
+{
+    size_t i = 0;
+
+    const __m128i Max = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+    __m128i Prev = _mm_setzero_si128();
+    __m128i Incomplete = _mm_setzero_si128();
+    for (; i + 64 <= Len; i += 64)
+    {
+        const __m128i A = _mm_loadu_si128((const __m128i*)(Data + i));
+        const __m128i B = _mm_loadu_si128((const __m128i*)(Data + i + 16));
+        const __m128i C = _mm_loadu_si128((const __m128i*)(Data + i + 32));
+        const __m128i D = _mm_loadu_si128((const __m128i*)(Data + i + 48));
+        __m128i Error = Incomplete;
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(A, B),
+            _mm_or_si128(C, D))))
+        {
+            Error = _mm_or_si128(
+                _mm_or_si128(_utf8Block(A, Prev), _utf8Block(B, A)),
+                _mm_or_si128(_utf8Block(C, B), _utf8Block(D, C)));
+            Incomplete = _mm_subs_epu8(D, Max);
+            Prev = D;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(Error, _mm_setzero_si128()))
+            != 0xFFFF)
+            break;
+    }
+    return (i);
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Checks 64-byte chunks with the lookup validator, using AVX2 or
+/// SSSE3 when the CPU has them.
+///
+/// Pure ASCII chunks are skipped after a single test. A sequence left
+/// incomplete at the end of a chunk is checked against the next chunk,
+/// and only counts as an error when that chunk is pure ASCII.
+///
+/// \return The length of the prefix known to be valid, up to a sequence
+/// that may be cut at its end: a multiple of 64, `Len` rounded down when
+/// the input is valid, and 0 without a vector kernel.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _utf8VectorPrefix(const char* Data, size_t Len)
+{
+#if defined(AX_AVX2_KERNELS)
+    if (_cpuHasAvx2())
+        return (_utf8PrefixAvx2(Data, Len));
+#endif
+#if defined(AX_SSSE3_KERNELS)
+    if (_cpuHasSsse3())
+        return (_utf8PrefixSsse3(Data, Len));
+#endif
+    (void)Data;
+    (void)Len;
+    return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Finds the first invalid UTF-8 sequence.
+///
+/// The vector validator vouches for a prefix; the rest of the input, or the
+/// chunk where an error shows up, is handed to the scalar validator from
+/// the last sequence start, which gives the exact offset.
+///
+/// \return The offset of the first invalid sequence, or `Len`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _validateUtf8(const char* Data, size_t Len)
+{
+    const size_t i = _utf8VectorPrefix(Data, Len);
+
+    // Everything before `i` is valid, except maybe a sequence cut by the
+    // chunk boundary: restart from the first sequence start in the last
+    // three bytes.
+    size_t Start = i < 3 ? 0 : i - 3;
+    while (Start < i && (static_cast<unsigned char>(Data[Start]) & 0xC0) == 0x80)
+        Start++;
+    return (_utf8Scalar(Data, Len, Start));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Counts the bytes that are not UTF-8 continuation bytes, which is
+/// the number of code points of valid UTF-8.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _countLeads(const char* Data, size_t Len)
+{
+    size_t Count = 0;
+    sizeType i = 0;
+#if defined(__AVX2__)
+    const __m256i Cont32 = _mm256_set1_epi8(char(0xBF));
+    for (; i + 32 <= Len; i += 32)
+    {
+        const __m256i Block = _mm256_loadu_si256((const __m256i*)(Data + i));
+        Count += __builtin_popcount(static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpgt_epi8(Block, Cont32))));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i Cont16 = _mm_set1_epi8(char(0xBF));
+    for (; i + 16 <= Len; i += 16)
+    {
+        const __m128i Block = _mm_loadu_si128((const __m128i*)(Data + i));
+        Count += __builtin_popcount(static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(Block, Cont16))));
+    }
+#endif
+    for (; i < Len; ++i)
+        Count += (static_cast<signed char>(Data[i]) > -65);
+    return (Count);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Finds the byte offset of the `N`th byte that is not a UTF-8
+/// continuation byte.
+///
+/// \return The offset, `Len` if there are exactly `N` such bytes, or `npos`
+/// if there are fewer.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _nthLead(const char* Data, size_t Len, size_t N)
+{
+    sizeType i = 0;
+#if defined(__SSE2__)
+    const __m128i Cont16 = _mm_set1_epi8(char(0xBF));
+    for (; i + 16 <= Len; i += 16)
+    {
+        const __m128i Block = _mm_loadu_si128((const __m128i*)(Data + i));
+        uint32_t Mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(Block, Cont16)));
+        const size_t Count = __builtin_popcount(Mask);
+        if (N >= Count)
+        {
+            N -= Count;
+            continue;
+        }
+        while (N--)
+            Mask &= Mask - 1;
+        return (i + __builtin_ctz(Mask));
+    }
+#endif
+    for (; i < Len; ++i)
+    {
+        if (static_cast<signed char>(Data[i]) > -65 && N-- == 0)
+            return (i);
+    }
+    return (N == 0 ? Len : TString::npos);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Widens the leading run of ASCII bytes to UTF-16 or UTF-32 units.
+///
+/// \return The number of bytes copied.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static size_t _widenAscii(const char* Src, size_t Len, T* Dst)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i Zero = _mm_setzero_si128();
+    for (; i + 16 <= Len; i += 16)
+    {
+        const __m128i Block = _mm_loadu_si128((const __m128i*)(Src + i));
+        if (_mm_movemask_epi8(Block))
+            break;
+        const __m128i Lo = _mm_unpacklo_epi8(Block, Zero);
+        const __m128i Hi = _mm_unpackhi_epi8(Block, Zero);
+        if constexpr (sizeof(T) == 2)
+        {
+            _mm_storeu_si128((__m128i*)(Dst + i), Lo);
+            _mm_storeu_si128((__m128i*)(Dst + i + 8), Hi);
+        }
+        else
+        {
+            _mm_storeu_si128((__m128i*)(Dst + i), _mm_unpacklo_epi16(Lo, Zero));
+            _mm_storeu_si128((__m128i*)(Dst + i + 4),
+                _mm_unpackhi_epi16(Lo, Zero));
+            _mm_storeu_si128((__m128i*)(Dst + i + 8),
+                _mm_unpacklo_epi16(Hi, Zero));
+            _mm_storeu_si128((__m128i*)(Dst + i + 12),
+                _mm_unpackhi_epi16(Hi, Zero));
+        }
+    }
+#endif
+    for (; i < Len && static_cast<unsigned char>(Src[i]) < 0x80; ++i)
+        Dst[i] = static_cast<T>(Src[i]);
+    return (i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Narrows the leading run of ASCII UTF-16 or UTF-32 units to bytes.
+///
+/// \return The number of units copied.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static size_t _narrowAscii(const T* Src, size_t Len, char* Dst)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    constexpr size_t Lanes = 16 / sizeof(T);
+    const __m128i High = sizeof(T) == 2 ? _mm_set1_epi16(short(0xFF80))
+        : _mm_set1_epi32(int(0xFFFFFF80));
+    const __m128i Zero = _mm_setzero_si128();
+    for (; i + 16 <= Len; i += 16)
+    {
+        __m128i Block[16 / Lanes];
+        __m128i Any = Zero;
+        for (size_t k = 0; k < 16 / Lanes; ++k)
+        {
+            Block[k] = _mm_loadu_si128((const __m128i*)(Src + i + k * Lanes));
+            Any = _mm_or_si128(Any, Block[k]);
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(Any, High), Zero))
+            != 0xFFFF)
+            break;
+        if constexpr (sizeof(T) == 2)
+            _mm_storeu_si128((__m128i*)(Dst + i),
+                _mm_packus_epi16(Block[0], Block[1]));
+        else
+            _mm_storeu_si128((__m128i*)(Dst + i), _mm_packus_epi16(
+                _mm_packs_epi32(Block[0], Block[1]),
+                _mm_packs_epi32(Block[2], Block[3])));
+    }
+#endif
+    for (; i < Len && static_cast<uint32_t>(Src[i]) < 0x80; ++i)
+        Dst[i] = static_cast<char>(Src[i]);
+    return (i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Transcodes valid UTF-8 to UTF-16 or UTF-32.
+///
+/// \param Dst Receives the units, must hold `Len` of them.
+///
+/// \return The number of units written.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static size_t _utf8To(const char* Src, size_t Len, T* Dst)
+{
+    size_t i = 0;
+    size_t Out = 0;
+
+    while (i < Len)
+    {
+        const size_t Ascii = _widenAscii(Src + i, Len - i, Dst + Out);
+        i += Ascii;
+        Out += Ascii;
+        while (i < Len && static_cast<unsigned char>(Src[i]) >= 0x80)
+        {
+            const char32_t Code = _decodeUtf8(Src, Len, i);
+            if (sizeof(T) == 2 && Code >= 0x10000)
+            {
+                Dst[Out++] = static_cast<T>(0xD7C0 + (Code >> 10));
+                Dst[Out++] = static_cast<T>(0xDC00 | (Code & 0x3FF));
+            }
+            else
+                Dst[Out++] = static_cast<T>(Code);
+        }
+    }
+    return (Out);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Reads one code point from UTF-16 or UTF-32.
+///
+/// \param Pos Position of the code point, moved past it.
+///
+/// \return The code point, or `char32_t(-1)` if the unit at `Pos` is an
+/// unpaired surrogate or out of range.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static char32_t _readUnit(const T* Src, size_t Len, size_t& Pos)
+{
+    const char32_t Code = Src[Pos];
+
+    if (Code >= 0xD800 && Code <= 0xDFFF)
+    {
+        if (sizeof(T) != 2 || Code > 0xDBFF || Pos + 1 == Len ||
+            Src[Pos + 1] < 0xDC00 || Src[Pos + 1] > 0xDFFF)
+            return (char32_t(-1));
+        Pos += 2;
+        return (0x10000 + ((Code - 0xD800) << 10) + (Src[Pos - 1] - 0xDC00));
+    }
+    if (Code > 0x10FFFF)
+        return (char32_t(-1));
+    Pos++;
+    return (Code);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Measures the UTF-8 form of UTF-16 or UTF-32 input.
+///
+/// \param ErrorOffset Receives the first invalid unit, or `npos`.
+///
+/// \return The number of bytes, or `npos` if the input is invalid.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static size_t _utf8Size(const T* Src, size_t Len, size_t& ErrorOffset)
+{
+    size_t Size = 0;
+
+    for (size_t i = 0; i < Len;)
+    {
+        const size_t At = i;
+        const char32_t Code = _readUnit(Src, Len, i);
+        if (Code == char32_t(-1))
+        {
+            ErrorOffset = At;
+            return (TString::npos);
+        }
+        Size += 1 + (Code >= 0x80) + (Code >= 0x800) + (Code >= 0x10000);
+    }
+    ErrorOffset = TString::npos;
+    return (Size);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Transcodes valid UTF-16 or UTF-32 to UTF-8.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void _utf8From(const T* Src, size_t Len, char* Dst)
+{
+    size_t i = 0;
+    size_t Out = 0;
+
+    while (i < Len)
+    {
+        const size_t Ascii = _narrowAscii(Src + i, Len - i, Dst + Out);
+        i += Ascii;
+        Out += Ascii;
+        while (i < Len && static_cast<uint32_t>(Src[i]) >= 0x80)
+            Out += _encodeUtf8(_readUnit(Src, Len, i), Dst + Out);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The 64 digits of each Base64 alphabet.
+///
+///////////////////////////////////////////////////////////////////////////////
+static const char* const _base64Digits[2] = {
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Maps each byte to its Base64 value, or -1, for both alphabets.
+///
+///////////////////////////////////////////////////////////////////////////////
+static const signed char* _base64Values(bool Url)
+{
+    struct Tables
+    {
+        signed char Values[2][256];
+        Tables(void)
+        {
+            ::memset(Values, -1, sizeof(Values));
+            for (int k = 0; k < 2; ++k)
+                for (int i = 0; i < 64; ++i)
+                    Values[k][(unsigned char)_base64Digits[k][i]] = i;
+        }
+    };
+    static const Tables Table;
+
+    return (Table.Values[Url]);
+}
+
+#if defined(AX_AVX2_KERNELS)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Encodes 3-byte groups with AVX2, 24 bytes per step.
+///
+/// Bytes are spread to 6-bit indices with a shuffle and two multiplies, and
+/// indices turn into digits by adding an offset picked from a 16-entry
+/// table by the range the index falls in (Mula and Lemire).
+///
+/// \return The number of bytes encoded, a multiple of 24; the rest is left
+/// to the scalar loop.
+///
+///////////////////////////////////////////////////////////////////////////////
+AX_TARGET_AVX2 static size_t _base64EncodeAvx2(const unsigned char* Src,
+    size_t Len, char* Dst, bool Url)
+{
+    const __m256i Spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8,
+        7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i Shift = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, Url ? '-' - 62 : '+' - 62, Url ? '_' - 63 : '/' - 63, 'A',
+        0, 0, 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        Url ? '-' - 62 : '+' - 62, Url ? '_' - 63 : '/' - 63, 'A', 0, 0);
+    size_t i = 0;
+    for (; i + 28 <= Len; i += 24, Dst += 32)
+    {
+        __m256i In = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128((const __m128i*)(Src + i))),
+            _mm_loadu_si128((const __m128i*)(Src + i + 12)), 1);
+        In = _mm256_shuffle_epi8(In, Spread);
+        const __m256i High = _mm256_mulhi_epu16(
+            _mm256_and_si256(In, _mm256_set1_epi32(0x0FC0FC00)),
+            _mm256_set1_epi32(0x04000040));
+        const __m256i Low = _mm256_mullo_epi16(
+            _mm256_and_si256(In, _mm256_set1_epi32(0x003F03F0)),
+            _mm256_set1_epi32(0x01000010));
+        const __m256i Index = _mm256_or_si256(High, Low);
+        __m256i Range = _mm256_subs_epu8(Index, _mm256_set1_epi8(51));
+        Range = _mm256_or_si256(Range, _mm256_and_si256(
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(26), Index),
+            _mm256_set1_epi8(13)));
+        _mm256_storeu_si256((__m256i*)Dst, _mm256_add_epi8(Index,
+            _mm256_shuffle_epi8(Shift, Range)));
+    }
+    return (i);
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Encodes whole 3-byte groups, with AVX2 when the CPU has it.
+///
+/// \param Src Input, `Len` must be a multiple of 3.
+/// \param Dst Receives `Len / 3 * 4` digits.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _base64Encode(const unsigned char* Src, size_t Len, char* Dst,
+    bool Url)
+{
+    const char* Digits = _base64Digits[Url];
+    size_t i = 0;
+
+#if defined(AX_AVX2_KERNELS)
+    if (_cpuHasAvx2())
+    {
+        i = _base64EncodeAvx2(Src, Len, Dst, Url);
+        Dst += i / 3 * 4;
+    }
+#endif
+    for (; i < Len; i += 3, Dst += 4)
+    {
+        const uint32_t Group = (Src[i] << 16) | (Src[i + 1] << 8) | Src[i + 2];
+        Dst[0] = Digits[Group >> 18];
+        Dst[1] = Digits[(Group >> 12) & 0x3F];
+        Dst[2] = Digits[(Group >> 6) & 0x3F];
+        Dst[3] = Digits[Group & 0x3F];
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Encodes the last one or two bytes of an input.
+///
+/// \return The number of characters written, 4 with padding.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _base64EncodeTail(const unsigned char* Src, size_t Len,
+    char* Dst, bool Url, bool Padding)
+{
+    const char* Digits = _base64Digits[Url];
+    const uint32_t Group = (Src[0] << 16) | (Len > 1 ? Src[1] << 8 : 0);
+
+    Dst[0] = Digits[Group >> 18];
+    Dst[1] = Digits[(Group >> 12) & 0x3F];
+    Dst[2] = Len > 1 ? Digits[(Group >> 6) & 0x3F] : '=';
+    Dst[3] = '=';
+    return (Padding ? 4 : Len + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Computes the length of the Base64 encoding of `Len` bytes.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _base64Size(size_t Len, bool Padding)
+{
+    const size_t Rest = Len % 3;
+
+    return (Len / 3 * 4 + (Rest ? (Padding ? 4 : Rest + 1) : 0));
+}
+
+#if defined(AX_AVX2_KERNELS)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Decodes 4-digit groups with AVX2, 32 digits per step.
+///
+/// Digits are classified with two nibble lookups whose intersection is
+/// non-zero only for bytes outside the alphabet, turned into values with a
+/// third lookup, and packed with two multiply-adds (Mula and Lemire). The
+/// URL alphabet is first mapped onto the standard one.
+///
+/// \param Room Bytes of room at `Dst`; a step stores 32 bytes, so the
+/// steps that would write past it are left to the scalar loop.
+///
+/// \return The number of digits decoded, a multiple of 32; it stops before
+/// the step holding an invalid digit, which the scalar loop locates.
+///
+///////////////////////////////////////////////////////////////////////////////
+AX_TARGET_AVX2 static size_t _base64DecodeAvx2(const char* Src, size_t Len,
+    unsigned char* Dst, bool Url, size_t Room)
+{
+    const __m256i LowTable = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13,
+        0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i HighTable = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04,
+        0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i RollTable = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71,
+        -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4, -65, -65, -71, -71, 0, 0,
+        0, 0, 0, 0, 0, 0);
+    const __m256i Pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13,
+        12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+        -1, -1);
+    const __m256i Nibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= Len && (i + 32) / 4 * 3 + 8 <= Room; i += 32, Dst += 24)
+    {
+        __m256i In = _mm256_loadu_si256((const __m256i*)(Src + i));
+        if (Url)
+        {
+            const __m256i Minus = _mm256_cmpeq_epi8(In, _mm256_set1_epi8('-'));
+            const __m256i Under = _mm256_cmpeq_epi8(In, _mm256_set1_epi8('_'));
+            const __m256i Std = _mm256_or_si256(
+                _mm256_cmpeq_epi8(In, _mm256_set1_epi8('+')),
+                _mm256_cmpeq_epi8(In, _mm256_set1_epi8('/')));
+            if (!_mm256_testz_si256(Std, Std))
+                break;
+            In = _mm256_blendv_epi8(In, _mm256_set1_epi8('+'), Minus);
+            In = _mm256_blendv_epi8(In, _mm256_set1_epi8('/'), Under);
+        }
+        const __m256i HighNibble = _mm256_and_si256(
+            _mm256_srli_epi32(In, 4), Nibble);
+        const __m256i Low = _mm256_shuffle_epi8(LowTable,
+            _mm256_and_si256(In, Nibble));
+        const __m256i High = _mm256_shuffle_epi8(HighTable, HighNibble);
+        if (!_mm256_testz_si256(Low, High))
+            break;
+        const __m256i Slash = _mm256_cmpeq_epi8(In, _mm256_set1_epi8('/'));
+        const __m256i Value = _mm256_add_epi8(In, _mm256_shuffle_epi8(
+            RollTable, _mm256_add_epi8(Slash, HighNibble)));
+        const __m256i Pairs = _mm256_maddubs_epi16(Value,
+            _mm256_set1_epi32(0x01400140));
+        const __m256i Words = _mm256_madd_epi16(Pairs,
+            _mm256_set1_epi32(0x00011000));
+        _mm256_storeu_si256((__m256i*)Dst, _mm256_permutevar8x32_epi32(
+            _mm256_shuffle_epi8(Words, Pack),
+            _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1)));
+    }
+    return (i);
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Decodes whole 4-digit groups, with AVX2 when the CPU has it.
+///
+/// \param Src Input, `Len` must be a multiple of 4.
+/// \param Dst Receives `Len / 4 * 3` bytes.
+/// \param Room Bytes of room at `Dst`, see `_base64DecodeAvx2`.
+///
+/// \return The offset of the first invalid digit, or `Len`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _base64Decode(const char* Src, size_t Len, unsigned char* Dst,
+    bool Url, size_t Room)
+{
+    const signed char* Values = _base64Values(Url);
+    size_t i = 0;
+
+#if defined(AX_AVX2_KERNELS)
+    if (_cpuHasAvx2())
+    {
+        i = _base64DecodeAvx2(Src, Len, Dst, Url, Room);
+        Dst += i / 4 * 3;
+    }
+#else
+    (void)Room;
+#endif
+    for (; i < Len; i += 4, Dst += 3)
+    {
+        const int A = Values[(unsigned char)Src[i]];
+        const int B = Values[(unsigned char)Src[i + 1]];
+        const int C = Values[(unsigned char)Src[i + 2]];
+        const int D = Values[(unsigned char)Src[i + 3]];
+        if ((A | B | C | D) < 0)
+            return (i + (A < 0 ? 0 : B < 0 ? 1 : C < 0 ? 2 : 3));
+        const uint32_t Group = (A << 18) | (B << 12) | (C << 6) | D;
+        Dst[0] = static_cast<unsigned char>(Group >> 16);
+        Dst[1] = static_cast<unsigned char>(Group >> 8);
+        Dst[2] = static_cast<unsigned char>(Group);
+    }
+    return (Len);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes two hexadecimal digits per byte, 16 bytes per step with
+/// SSE2.
+///
+/// \param Dst Receives `Len * 2` digits.
+/// \param Upper True for `A`-`F`, false for `a`-`f`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _hexEncode(const unsigned char* Src, size_t Len, char* Dst,
+    bool Upper)
+{
+    const char* Digits = Upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i Nibble = _mm_set1_epi8(0x0F);
+    const __m128i Nine = _mm_set1_epi8(9);
+    const __m128i Zero = _mm_set1_epi8('0');
+    const __m128i Letter = _mm_set1_epi8(Upper ? 'A' - '0' - 10 : 'a' - '0' - 10);
+    for (; i + 16 <= Len; i += 16)
+    {
+        const __m128i Block = _mm_loadu_si128((const __m128i*)(Src + i));
+        __m128i High = _mm_and_si128(_mm_srli_epi16(Block, 4), Nibble);
+        __m128i Low = _mm_and_si128(Block, Nibble);
+        High = _mm_add_epi8(_mm_add_epi8(High, Zero),
+            _mm_and_si128(_mm_cmpgt_epi8(High, Nine), Letter));
+        Low = _mm_add_epi8(_mm_add_epi8(Low, Zero),
+            _mm_and_si128(_mm_cmpgt_epi8(Low, Nine), Letter));
+        _mm_storeu_si128((__m128i*)(Dst + 2 * i), _mm_unpacklo_epi8(High, Low));
+        _mm_storeu_si128((__m128i*)(Dst + 2 * i + 16),
+            _mm_unpackhi_epi8(High, Low));
+    }
+#endif
+    for (; i < Len; ++i)
+    {
+        Dst[2 * i] = Digits[Src[i] >> 4];
+        Dst[2 * i + 1] = Digits[Src[i] & 0x0F];
+    }
+}
+
+#if defined(__SSE2__)
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Turns 16 hexadecimal digits into their values.
+///
+/// \param Valid Receives a non-zero byte for each digit that is valid.
+///
+///////////////////////////////////////////////////////////////////////////////
+static inline __m128i _hexValues(__m128i Block, __m128i& Valid)
+{
+    const __m128i Lower = _mm_or_si128(Block, _mm_set1_epi8(0x20));
+    const __m128i Digit = _mm_and_si128(
+        _mm_cmpgt_epi8(Block, _mm_set1_epi8('0' - 1)),
+        _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), Block));
+    const __m128i Alpha = _mm_and_si128(
+        _mm_cmpgt_epi8(Lower, _mm_set1_epi8('a' - 1)),
+        _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), Lower));
+
+    Valid = _mm_or_si128(Digit, Alpha);
+    return (_mm_or_si128(
+        _mm_and_si128(Digit, _mm_sub_epi8(Block, _mm_set1_epi8('0'))),
+        _mm_andnot_si128(Digit,
+            _mm_sub_epi8(Lower, _mm_set1_epi8('a' - 10)))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Packs 8 pairs of digit values, high digit first, into 8 bytes
+/// held in 16-bit lanes.
+///
+///////////////////////////////////////////////////////////////////////////////
+static inline __m128i _hexPairs(__m128i Values)
+{
+    return (_mm_or_si128(
+        _mm_slli_epi16(_mm_and_si128(Values, _mm_set1_epi16(0x00FF)), 4),
+        _mm_srli_epi16(Values, 8)));
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Reads pairs of hexadecimal digits, 32 digits per step with SSE2.
+///
+/// \param Src Input, `Len` must be even.
+/// \param Dst Receives `Len / 2` bytes.
+///
+/// \return The offset of the first invalid digit, or `Len`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _hexDecode(const char* Src, size_t Len, unsigned char* Dst)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 32 <= Len; i += 32)
+    {
+        __m128i ValidA;
+        __m128i ValidB;
+        const __m128i A = _hexValues(
+            _mm_loadu_si128((const __m128i*)(Src + i)), ValidA);
+        const __m128i B = _hexValues(
+            _mm_loadu_si128((const __m128i*)(Src + i + 16)), ValidB);
+        if (_mm_movemask_epi8(_mm_and_si128(ValidA, ValidB)) != 0xFFFF)
+            break;
+        _mm_storeu_si128((__m128i*)(Dst + i / 2),
+            _mm_packus_epi16(_hexPairs(A), _hexPairs(B)));
+    }
+#endif
+    for (; i < Len; i += 2)
+    {
+        int Value[2];
+        for (int k = 0; k < 2; ++k)
+        {
+            const int Ch = static_cast<unsigned char>(Src[i + k]);
+            if (Ch >= '0' && Ch <= '9')
+                Value[k] = Ch - '0';
+            else if ((Ch | 0x20) >= 'a' && (Ch | 0x20) <= 'f')
+                Value[k] = (Ch | 0x20) - 'a' + 10;
+            else
+                return (i + k);
+        }
+        Dst[i / 2] = static_cast<unsigned char>((Value[0] << 4) | Value[1]);
+    }
+    return (Len);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Builds the set of bytes each percent-encoding mode leaves as they
+/// are, once.
+///
+/// \param Mode 0 for a component, 1 for a path, 2 for a form value.
+///
+///////////////////////////////////////////////////////////////////////////////
+static const TString::ByteSet& _urlSafe(int Mode)
+{
+    static const char Alnum[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    static const std::string Chars[3] = {
+        std::string(Alnum) + "-._~",
+        std::string(Alnum) + "-._~!$&'()*+,;=:@/",
+        std::string(Alnum) + "*-._"
+    };
+    static const TString::ByteSet Sets[3] = {
+        TString::ByteSet(Chars[0].data(), Chars[0].size()),
+        TString::ByteSet(Chars[1].data(), Chars[1].size()),
+        TString::ByteSet(Chars[2].data(), Chars[2].size())
+    };
+
+    return (Sets[Mode]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Measures the run of bytes that are, or are not, in a set, 32 or 16
+/// bytes per step with AVX2 or SSSE3 when the set is ASCII.
+///
+/// \param Member True for a run of bytes in the set, false for a run of
+/// bytes out of it.
+///
+/// \return The length of the run.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _setRun(const char* Src, size_t Len, const TString::ByteSet& Set,
+    bool Member)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i Low32 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*)Set.Low));
+    const __m256i High32 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*)Set.High));
+    const __m256i Nibble32 = _mm256_set1_epi8(0x0F);
+    const uint32_t Flip32 = Member ? 0 : 0xFFFFFFFFu;
+    for (; Set.Ascii && i + 32 <= Len; i += 32)
+    {
+        const __m256i Block = _mm256_loadu_si256((const __m256i*)(Src + i));
+        const __m256i Rows = _mm256_and_si256(
+            _mm256_shuffle_epi8(Low32, _mm256_and_si256(Block, Nibble32)),
+            _mm256_shuffle_epi8(High32, _mm256_and_si256(
+                _mm256_srli_epi16(Block, 4), Nibble32)));
+        const uint32_t Stop = Flip32 ^ static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(Rows,
+            _mm256_setzero_si256())));
+        if (Stop)
+            return (i + __builtin_ctz(Stop));
+    }
+#endif
+#if defined(__SSSE3__)
+    const __m128i Low16 = _mm_loadu_si128((const __m128i*)Set.Low);
+    const __m128i High16 = _mm_loadu_si128((const __m128i*)Set.High);
+    const __m128i Nibble16 = _mm_set1_epi8(0x0F);
+    const uint32_t Flip16 = Member ? 0 : 0xFFFFu;
+    for (; Set.Ascii && i + 16 <= Len; i += 16)
+    {
+        const __m128i Block = _mm_loadu_si128((const __m128i*)(Src + i));
+        const __m128i Rows = _mm_and_si128(
+            _mm_shuffle_epi8(Low16, _mm_and_si128(Block, Nibble16)),
+            _mm_shuffle_epi8(High16, _mm_and_si128(
+                _mm_srli_epi16(Block, 4), Nibble16)));
+        const uint32_t Stop = Flip16 ^ static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(Rows, _mm_setzero_si128())));
+        if (Stop)
+            return (i + __builtin_ctz(Stop));
+    }
+#endif
+    while (i < Len && Set.Has[static_cast<unsigned char>(Src[i])] == Member)
+        i++;
+    return (i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Computes the length of the percent-encoding of a buffer.
+///
+/// \param Form True if a space is encoded as `+`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _urlEncodedSize(const char* Src, size_t Len,
+    const TString::ByteSet& Safe, bool Form)
+{
+    size_t Size = 0;
+
+    for (size_t i = 0; i < Len;)
+    {
+        const size_t Run = _setRun(Src + i, Len - i, Safe, true);
+        Size += Run;
+        for (i += Run; i < Len && !Safe.Has[(unsigned char)Src[i]]; ++i)
+            Size += Form && Src[i] == ' ' ? 1 : 3;
+    }
+    return (Size);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Percent-encodes a buffer into `_urlEncodedSize` bytes at `Dst`.
+///
+/// \param Form True if a space is encoded as `+`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _urlEncode(const char* Src, size_t Len,
+    const TString::ByteSet& Safe, bool Form, char* Dst)
+{
+    static const char Digits[] = "0123456789ABCDEF";
+
+    for (size_t i = 0; i < Len;)
+    {
+        const size_t Run = _setRun(Src + i, Len - i, Safe, true);
+        ::memcpy(Dst, Src + i, Run);
+        Dst += Run;
+        for (i += Run; i < Len && !Safe.Has[(unsigned char)Src[i]]; ++i)
+        {
+            const unsigned char Ch = static_cast<unsigned char>(Src[i]);
+            if (Form && Ch == ' ')
+            {
+                *Dst++ = '+';
+                continue;
+            }
+            Dst[0] = '%';
+            Dst[1] = Digits[Ch >> 4];
+            Dst[2] = Digits[Ch & 15];
+            Dst += 3;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Measures the run of bytes a percent-decoder copies verbatim, 16
+/// bytes per step with SSE2.
+///
+/// \param Form True if `+` stands for a space.
+///
+/// \return The length of the run.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _urlPlainRun(const char* Src, size_t Len, bool Form)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i Percent = _mm_set1_epi8('%');
+    const __m128i Plus = _mm_set1_epi8(Form ? '+' : '%');
+    for (; i + 16 <= Len; i += 16)
+    {
+        const __m128i Block = _mm_loadu_si128((const __m128i*)(Src + i));
+        const uint32_t Mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(Block, Percent),
+                _mm_cmpeq_epi8(Block, Plus))));
+        if (Mask)
+            return (i + __builtin_ctz(Mask));
+    }
+#endif
+    while (i < Len && Src[i] != '%' && !(Form && Src[i] == '+'))
+        i++;
+    return (i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Measures the run of bytes that need no JSON escaping, that is
+/// anything but `"`, `\\` and control characters, 32 or 16 bytes per step
+/// with AVX2 or SSE2.
+///
+/// \return The length of the run.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _jsonPlainRun(const char* Src, size_t Len)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i Quote32 = _mm256_set1_epi8('"');
+    const __m256i Slash32 = _mm256_set1_epi8('\\');
+    const __m256i Control32 = _mm256_set1_epi8(0x1F);
+    for (; i + 32 <= Len; i += 32)
+    {
+        const __m256i Block = _mm256_loadu_si256((const __m256i*)(Src + i));
+        const uint32_t Mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_or_si256(
+                _mm256_cmpeq_epi8(Block, Quote32),
+                _mm256_cmpeq_epi8(Block, Slash32)),
+                _mm256_cmpeq_epi8(_mm256_min_epu8(Block, Control32), Block))));
+        if (Mask)
+            return (i + __builtin_ctz(Mask));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i Quote16 = _mm_set1_epi8('"');
+    const __m128i Slash16 = _mm_set1_epi8('\\');
+    const __m128i Control16 = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= Len; i += 16)
+    {
+        const __m128i Block = _mm_loadu_si128((const __m128i*)(Src + i));
+        const uint32_t Mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_or_si128(
+                _mm_cmpeq_epi8(Block, Quote16),
+                _mm_cmpeq_epi8(Block, Slash16)),
+                _mm_cmpeq_epi8(_mm_min_epu8(Block, Control16), Block))));
+        if (Mask)
+            return (i + __builtin_ctz(Mask));
+    }
+#endif
+    for (; i < Len; ++i)
+    {
+        const unsigned char Ch = static_cast<unsigned char>(Src[i]);
+        if (Ch == '"' || Ch == '\\' || Ch < 0x20)
+            break;
+    }
+    return (i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gives the letter of the short JSON escape of a byte.
+///
+/// \return The letter, or 0 if the byte is written as `\\u00XX`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static char _jsonShortEscape(unsigned char Ch)
+{
+    switch (Ch)
+    {
+        case '"': return ('"');
+        case '\\': return ('\\');
+        case '\b': return ('b');
+        case '\f': return ('f');
+        case '\n': return ('n');
+        case '\r': return ('r');
+        case '\t': return ('t');
+        default: return (0);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Reads the code point of a JSON escape, pairing surrogates.
+///
+/// \param Src The escape, starting with its backslash.
+/// \param Len Number of bytes available at `Src`.
+/// \param Size Receives the length of the escape.
+///
+/// \return The code point, or `char32_t(-1)` if the escape is invalid.
+///
+///////////////////////////////////////////////////////////////////////////////
+static char32_t _jsonEscape(const char* Src, size_t Len, size_t& Size)
+{
+    unsigned char Unit[2];
+
+    Size = 2;
+    if (Len < 2)
+        return (char32_t(-1));
+    switch (Src[1])
+    {
+        case '"': return ('"');
+        case '\\': return ('\\');
+        case '/': return ('/');
+        case 'b': return ('\b');
+        case 'f': return ('\f');
+        case 'n': return ('\n');
+        case 'r': return ('\r');
+        case 't': return ('\t');
+        case 'u': break;
+        default: return (char32_t(-1));
+    }
+    if (Len < 6 || _hexDecode(Src + 2, 4, Unit) != 4)
+        return (char32_t(-1));
+    Size = 6;
+
+    const char32_t High = (Unit[0] << 8) | Unit[1];
+    if (High < 0xD800 || High > 0xDFFF)
+        return (High);
+    if (High > 0xDBFF || Len < 12 || Src[6] != '\\' || Src[7] != 'u' ||
+        _hexDecode(Src + 8, 4, Unit) != 4)
+        return (char32_t(-1));
+
+    const char32_t Low = (Unit[0] << 8) | Unit[1];
+    if (Low < 0xDC00 || Low > 0xDFFF)
+        return (char32_t(-1));
+    Size = 12;
+    return (0x10000 + ((High - 0xD800) << 10) + (Low - 0xDC00));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The two digits of every number below 100.
+///
+///////////////////////////////////////////////////////////////////////////////
+static const char _digitPairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Counts the decimal digits of a number.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _digitCount(uint64_t Value)
+{
+    size_t Count = 1;
+
+    for (uint64_t Power = 10; Count < 20 && Value >= Power; Power *= 10)
+        Count++;
+    return (Count);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes the decimal digits of a number, two at a time, backwards
+/// from the end of their place.
+///
+/// \param End One past the place of the last digit.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _writeDigits(char* End, uint64_t Value)
+{
+    while (Value >= 100)
+    {
+        const size_t Pair = (Value % 100) * 2;
+        Value /= 100;
+        *--End = _digitPairs[Pair + 1];
+        *--End = _digitPairs[Pair];
+    }
+    if (Value >= 10)
+    {
+        *--End = _digitPairs[Value * 2 + 1];
+        *--End = _digitPairs[Value * 2];
+    }
+    else
+        *--End = static_cast<char>('0' + Value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Finds the first byte where two buffers differ once folded.
+///
+/// Blocks that are already byte-equal skip the folding entirely.
+///
+/// \return The offset of the first difference, or `Len`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _mismatchFold(const char* A, const char* B, size_t Len)
+{
+    sizeType i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= Len; i += 16)
+    {
+        const __m128i X = _mm_loadu_si128((const __m128i*)(A + i));
+        const __m128i Y = _mm_loadu_si128((const __m128i*)(B + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(X, Y)) == 0xFFFF)
+            continue;
+        const uint32_t Mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_foldAscii(X), _foldAscii(Y))));
+        if (Mask != 0xFFFF)
+            return (i + __builtin_ctz(~Mask));
+    }
+#endif
+    for (; i < Len; ++i)
+    {
+        if (_foldAscii(static_cast<unsigned char>(A[i])) !=
+            _foldAscii(static_cast<unsigned char>(B[i])))
+            return (i);
+    }
+    return (Len);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Finds the first occurrence of a needle in a buffer, ignoring ASCII
+/// case.
+///
+/// \return A pointer to the occurrence, or null.
+///
+///////////////////////////////////////////////////////////////////////////////
+static const char* _searchBytesFold(const char* Hay, size_t HayLen,
+    const char* Needle, size_t Len)
+{
+    if (Len == 0)
+        return (Hay);
+    if (Len > HayLen)
+        return (nullptr);
+
+    const unsigned char First = _foldAscii(static_cast<unsigned char>(*Needle));
+    const unsigned char Final = _foldAscii(
+        static_cast<unsigned char>(Needle[Len - 1]));
+    const size_t Last = HayLen - Len;
+    sizeType i = 0;
+#if defined(__SSE2__)
+    const __m128i First16 = _mm_set1_epi8(static_cast<char>(First));
+    const __m128i Final16 = _mm_set1_epi8(static_cast<char>(Final));
+    for (; i + 16 <= Last + 1; i += 16)
+    {
+        const __m128i A = _foldAscii(_mm_loadu_si128((const __m128i*)(Hay + i)));
+        const __m128i B = _foldAscii(
+            _mm_loadu_si128((const __m128i*)(Hay + i + Len - 1)));
+        uint32_t Mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(A, First16),
+            _mm_cmpeq_epi8(B, Final16))));
+        while (Mask)
+        {
+            const sizeType At = i + __builtin_ctz(Mask);
+            if (_mismatchFold(Hay + At, Needle, Len) == Len)
+                return (Hay + At);
+            Mask &= Mask - 1;
+        }
+    }
+#endif
+    for (; i <= Last; ++i)
+    {
+        if (_foldAscii(static_cast<unsigned char>(Hay[i])) == First &&
+            _foldAscii(static_cast<unsigned char>(Hay[i + Len - 1])) == Final
+            && _mismatchFold(Hay + i, Needle, Len) == Len)
+            return (Hay + i);
+    }
+    return (nullptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Pattern preprocessed for Myers' bit-parallel edit distance.
+///
+/// `Peq[Ch * Blocks + b]` has bit `i` set when row `64 * b + i` of the
+/// pattern holds `Ch`.
+///
+///////////////////////////////////////////////////////////////////////////////
+struct _MyersPattern
+{
+    size_t Len = 0;
+    size_t Blocks = 0;
+    uint64_t LastBit = 0;
+    std::vector<uint64_t> Peq;
+
+    _MyersPattern(const char* Str, size_t n, bool Reverse = false)
+        : Len(n), Blocks((n + 63) / 64), LastBit(uint64_t(1) << ((n + 63) % 64))
+    {
+        Peq.assign(Blocks * 256, 0);
+        for (sizeType i = 0; i < n; ++i)
+        {
+            const unsigned char Ch = static_cast<unsigned char>(
+                Reverse ? Str[n - 1 - i] : Str[i]);
+            Peq[Ch * Blocks + i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Advances one 64-row block of the edit distance matrix by one column.
+///
+/// \return The horizontal delta leaving the row selected by `High`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static inline int _myersBlock(uint64_t& Pv, uint64_t& Mv, uint64_t Eq, int Hin,
+    uint64_t High)
+{
+    const uint64_t Xv = Eq | Mv;
+    if (Hin < 0)
+        Eq |= 1;
+    const uint64_t Xh = (((Eq & Pv) + Pv) ^ Pv) | Eq;
+    uint64_t Ph = Mv | ~(Xh | Pv);
+    uint64_t Mh = Pv & Xh;
+    int Hout = 0;
+
+    if (Ph & High)
+        Hout = 1;
+    else if (Mh & High)
+        Hout = -1;
+    Ph <<= 1;
+    Mh <<= 1;
+    if (Hin < 0)
+        Mh |= 1;
+    else if (Hin > 0)
+        Ph |= 1;
+    Pv = Mh | ~(Xv | Ph);
+    Mv = Ph & Xv;
+    return (Hout);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Runs Myers' algorithm over a text, one column per character.
+///
+/// In global mode the pattern has to match from the first character of the
+/// text, in search mode it may start anywhere. `Column` is called with the
+/// number of consumed characters and the distance of the whole pattern at
+/// that point, and stops the run by returning false.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <typename F>
+static void _myersRun(const _MyersPattern& Pattern, const char* Text,
+    size_t Len, bool Global, int Step, F Column)
+{
+    const size_t Blocks = Pattern.Blocks;
+    const uint64_t Top = uint64_t(1) << 63;
+    uint64_t SinglePv = ~uint64_t(0);
+    uint64_t SingleMv = 0;
+    std::vector<uint64_t> Pv;
+    std::vector<uint64_t> Mv;
+    size_t Score = Pattern.Len;
+
+    if (Blocks > 1)
+    {
+        Pv.assign(Blocks, ~uint64_t(0));
+        Mv.assign(Blocks, 0);
+    }
+    for (sizeType j = 0; j < Len; ++j)
+    {
+        const unsigned char Ch = static_cast<unsigned char>(
+            Step > 0 ? Text[j] : Text[-static_cast<std::ptrdiff_t>(j)]);
+        const uint64_t* Eq = &Pattern.Peq[Ch * Blocks];
+        int Hout = Global ? 1 : 0;
+
+        if (Blocks == 1)
+            Hout = _myersBlock(SinglePv, SingleMv, Eq[0], Hout, Pattern.LastBit);
+        else
+        {
+            for (sizeType b = 0; b < Blocks; ++b)
+            {
+                Hout = _myersBlock(Pv[b], Mv[b], Eq[b], Hout,
+                    b + 1 == Blocks ? Pattern.LastBit : Top);
+            }
+        }
+        Score += Hout;
+        if (!Column(j + 1, Score))
+            return;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Computes a bounded Levenshtein distance against a preprocessed
+/// pattern.
+///
+/// \return The distance, or `npos` if it is greater than `K`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _editDistance(const _MyersPattern& Pattern, const char* Text,
+    size_t Len, size_t K)
+{
+    const size_t Diff = Pattern.Len > Len ? Pattern.Len - Len :
+        Len - Pattern.Len;
+    size_t Score = Pattern.Len;
+
+    if (Diff > K)
+        return (TString::npos);
+    if (Pattern.Len == 0 || Len == 0)
+        return (Diff);
+    _myersRun(Pattern, Text, Len, true, 1, [&](size_t Column, size_t Value)
+    {
+        Score = Value;
+        // Each remaining column lowers the last row by one at most.
+        return (Value <= Len - Column || Value - (Len - Column) <= K);
+    });
+    return (Score <= K ? Score : TString::npos);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Runs `Work` on every chunk index with a pool of threads.
+///
+/// Chunks are handed out in increasing order; the calling thread takes part
+/// in the work.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <typename F>
+static void _parallelFor(size_t Count, size_t Threads, F Work)
+{
+    std::atomic<size_t> Next(0);
+    std::vector<std::thread> Pool;
+    auto Worker = [&](void)
+    {
+        for (size_t i = Next++; i < Count; i = Next++)
+            Work(i);
+    };
+
+    Threads = std::min(Threads, Count);
+    for (size_t t = 1; t < Threads; ++t)
+        Pool.emplace_back(Worker);
+    Worker();
+    for (std::thread& Thread : Pool)
+        Thread.join();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A string being sorted, with the 8 bytes following the current
+/// depth cached as a big-endian integer.
+///
+///////////////////////////////////////////////////////////////////////////////
+struct _SortItem
+{
+    uint64_t Key;   //<! Bytes from the depth, zero padded.
+    size_t Len;     //<! Bytes left from the depth, clamped to 8.
+    TString* Str;   //<! The string.
+};
+
+///////////////////////////////////////////////////////////////////////////////
+static inline void _loadSortKey(_SortItem& Item, size_t Depth)
+{
+    const size_t Left = Item.Str->Length() - Depth;
+    unsigned char Bytes[8] = {0};
+
+    Item.Len = Left < 8 ? Left : 8;
+    if (Item.Len)
+        ::memcpy(Bytes, Item.Str->CStr() + Depth, Item.Len);
+    Item.Key = 0;
+    for (size_t i = 0; i < 8; ++i)
+        Item.Key = (Item.Key << 8) | Bytes[i];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Orders items on their cached bytes.
+///
+/// Zero padding makes a string ending inside the cached bytes compare equal
+/// to one going on with NULs; the clamped length then puts it first.
+///
+///////////////////////////////////////////////////////////////////////////////
+static inline bool _sortLess(const _SortItem& A, const _SortItem& B)
+{
+    return (A.Key < B.Key || (A.Key == B.Key && A.Len < B.Len));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static bool _sortLessFrom(const _SortItem& A, const _SortItem& B, size_t Depth)
+{
+    if (A.Key != B.Key || A.Len != B.Len || A.Len < 8)
+        return (_sortLess(A, B));
+
+    const size_t From = Depth + 8;
+    const size_t LenA = A.Str->Length() - From;
+    const size_t LenB = B.Str->Length() - From;
+    const size_t Len = LenA < LenB ? LenA : LenB;
+    const int Diff = Len ? ::memcmp(A.Str->CStr() + From,
+        B.Str->CStr() + From, Len) : 0;
+    return (Diff ? Diff < 0 : LenA < LenB);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Multikey quicksort of items whose first `Depth` bytes are equal.
+///
+/// Three-way partitions on the cached bytes; the items equal to the pivot
+/// move on to the next 8 bytes unless the pivot string ended.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _multikeySort(_SortItem* Items, size_t Count, size_t Depth)
+{
+    while (Count > 1)
+    {
+        if (Count < 16)
+        {
+            for (size_t i = 1; i < Count; ++i)
+            {
+                _SortItem Item = Items[i];
+                size_t j = i;
+                for (; j > 0 && _sortLessFrom(Item, Items[j - 1], Depth); --j)
+                    Items[j] = Items[j - 1];
+                Items[j] = Item;
+            }
+            return;
+        }
+
+        _SortItem Pivot = Items[Count / 2];
+        const _SortItem& First = Items[0];
+        const _SortItem& Last = Items[Count - 1];
+        if (_sortLess(First, Pivot) != _sortLess(First, Last))
+            Pivot = First;
+        else if (_sortLess(Last, Pivot) != _sortLess(Last, First))
+            Pivot = Last;
+
+        size_t Lower = 0;
+        size_t Upper = Count;
+        for (size_t i = 0; i < Upper;)
+        {
+            if (_sortLess(Items[i], Pivot))
+                std::swap(Items[Lower++], Items[i++]);
+            else if (_sortLess(Pivot, Items[i]))
+                std::swap(Items[i], Items[--Upper]);
+            else
+                i++;
+        }
+
+        // The items equal to the pivot go on at the next depth, unless the
+        // pivot string ended and they are all equal.
+        _SortItem* Parts[3] = {Items, Items + Upper, Items + Lower};
+        const size_t Counts[3] = {Lower, Count - Upper,
+            Pivot.Len < 8 ? 0 : Upper - Lower};
+        const size_t Depths[3] = {Depth, Depth, Depth + 8};
+        for (size_t i = 0; i < Counts[2]; ++i)
+            _loadSortKey(Parts[2][i], Depths[2]);
+
+        // Only the smaller parts are sorted recursively, each at most half
+        // the items, and the largest one in this loop; the stack depth is
+        // then logarithmic whatever the input.
+        size_t Largest = Counts[1] > Counts[0] ? 1 : 0;
+        if (Counts[2] > Counts[Largest])
+            Largest = 2;
+        for (size_t k = 0; k < 3; ++k)
+        {
+            if (k != Largest)
+                _multikeySort(Parts[k], Counts[k], Depths[k]);
+        }
+        Items = Parts[Largest];
+        Count = Counts[Largest];
+        Depth = Depths[Largest];
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Moves the strings in the order of the sorted items, then fills
+/// the LCP values if asked.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _applySortOrder(std::vector<TString>& Strings,
+    const std::vector<_SortItem>& Items, std::vector<size_t>* Lcp)
+{
+    std::vector<TString> Sorted;
+
+    Sorted.reserve(Items.size());
+    for (const _SortItem& Item : Items)
+        Sorted.push_back(std::move(*Item.Str));
+    Strings.swap(Sorted);
+    if (!Lcp)
+        return;
+    Lcp->assign(Strings.size(), 0);
+    for (size_t i = 1; i < Strings.size(); ++i)
+    {
+        const char* A = Strings[i - 1].CStr();
+        const char* B = Strings[i].CStr();
+        const size_t Len = std::min(Strings[i - 1].Length(),
+            Strings[i].Length());
+        size_t At = 0;
+        while (At + 8 <= Len && ::memcmp(A + At, B + At, 8) == 0)
+            At += 8;
+        while (At < Len && A[At] == B[At])
+            At++;
+        (*Lcp)[i] = At;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief wyhash (final version 4) primitives and secret.
+///
+///////////////////////////////////////////////////////////////////////////////
+static const uint64_t _wySecret[4] = {
+    0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+    0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+};
+
+///////////////////////////////////////////////////////////////////////////////
+static inline void _wyMum(uint64_t& A, uint64_t& B)
+{
+    __uint128_t Product = static_cast<__uint128_t>(A) * B;
+    A = static_cast<uint64_t>(Product);
+    B = static_cast<uint64_t>(Product >> 64);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static inline uint64_t _wyMix(uint64_t A, uint64_t B)
+{
+    _wyMum(A, B);
+    return (A ^ B);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static inline uint64_t _wyRead8(const unsigned char* Ptr)
+{
+    uint64_t Value;
+    ::memcpy(&Value, Ptr, 8);
+    return (Value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static inline uint64_t _wyRead4(const unsigned char* Ptr)
+{
+    uint32_t Value;
+    ::memcpy(&Value, Ptr, 4);
+    return (Value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Hashes `Len` bytes with wyhash.
+///
+/// Inputs over 48 bytes are consumed by three independent multiply chains,
+/// which keeps the multipliers busy on long strings.
+///
+///////////////////////////////////////////////////////////////////////////////
+static uint64_t _wyHash(const unsigned char* Ptr, size_t Len, uint64_t Seed)
+{
+    const uint64_t* S = _wySecret;
+    uint64_t A;
+    uint64_t B;
+
+    Seed ^= _wyMix(Seed ^ S[0], S[1]);
+    if (Len <= 16)
+    {
+        if (Len >= 4)
+        {
+            const size_t Shift = (Len >> 3) << 2;
+            A = (_wyRead4(Ptr) << 32) | _wyRead4(Ptr + Shift);
+            B = (_wyRead4(Ptr + Len - 4) << 32) |
+                _wyRead4(Ptr + Len - 4 - Shift);
+        }
+        else if (Len > 0)
+        {
+            A = (uint64_t(Ptr[0]) << 16) | (uint64_t(Ptr[Len >> 1]) << 8) |
+                Ptr[Len - 1];
+            B = 0;
+        }
+        else
+            A = B = 0;
+    }
+    else
+    {
+        size_t i = Len;
+        if (i > 48)
+        {
+            uint64_t See1 = Seed;
+            uint64_t See2 = Seed;
+            do
+            {
+                Seed = _wyMix(_wyRead8(Ptr) ^ S[1], _wyRead8(Ptr + 8) ^ Seed);
+                See1 = _wyMix(_wyRead8(Ptr + 16) ^ S[2],
+                    _wyRead8(Ptr + 24) ^ See1);
+                See2 = _wyMix(_wyRead8(Ptr + 32) ^ S[3],
+                    _wyRead8(Ptr + 40) ^ See2);
+                Ptr += 48;
+                i -= 48;
+            } while (i > 48);
+            Seed ^= See1 ^ See2;
+        }
+        while (i > 16)
+        {
+            Seed = _wyMix(_wyRead8(Ptr) ^ S[1], _wyRead8(Ptr + 8) ^ Seed);
+            i -= 16;
+            Ptr += 16;
+        }
+        A = _wyRead8(Ptr + i - 16);
+        B = _wyRead8(Ptr + i - 8);
+    }
+    A ^= S[1];
+    B ^= Seed;
+    _wyMum(A, B);
+    return (_wyMix(A ^ S[0] ^ Len, B ^ S[1]));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 TString::TString(void)
 {
-    _setCapacity(0);
-    _setLength(0);
+    _setCapacity(0);
+    _setLength(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::TString(const TString& Other)
+{
+    _append(Other._str, Other._strLen);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::TString(const TString& Other, sizeType Pos, size_t Len)
+{
+    Append(Other, Pos, Len);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::TString(TString&& Other)
+{
+    *this = std::move(Other);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::TString(const char* Other)
+{
+    _append(Other);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::TString(const char* Other, size_t Len)
+{
+    Append(Other, 0, Len);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::TString(size_t Len, char Filler)
+{
+    Append(Len, Filler);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::TString(const ConstIterator First, const ConstIterator Second)
+{
+    Append(First, Second);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::TString(size_t Cap, ReserveTag)
+{
+    _allocCString(_str, Cap);
+    _strCap = Cap;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::operator=(const TString& Other)
+{
+    if (this != &Other)
+    {
+        _setLength(0);
+        _append(Other._str, Other._strLen);
+    }
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::operator=(TString&& Other)
+{
+    if (this != &Other)
+    {
+        SafeDeleteArray(_str);
+        _str = Other._str;
+        _strLen = Other._strLen;
+        _strCap = Other._strCap;
+        Other._str = nullptr;
+        Other._strLen = 0;
+        Other._strCap = 0;
+    }
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::~TString(void)
+{
+    SafeDeleteArray(_str);
+    _strLen = 0;
+    _strCap = 0;
+    _increaseBy = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool operator==(const TString& Lhs, const TString& Rhs)
+{
+    if (Lhs._strLen != Rhs._strLen)
+        return (false);
+    return (Lhs._str == Rhs._str || Lhs._strLen == 0 ||
+        ::memcmp(Lhs._str, Rhs._str, Lhs._strLen) == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool operator!=(const TString& Lhs, const TString& Rhs)
+{
+    return (!(Lhs == Rhs));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool operator<(const TString& Lhs, const TString& Rhs)
+{
+    return (Lhs._compare(Rhs) < 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool operator>(const TString& Lhs, const TString& Rhs)
+{
+    return (Lhs._compare(Rhs) > 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool operator<=(const TString& Lhs, const TString& Rhs)
+{
+    return (Lhs._compare(Rhs) <= 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool operator>=(const TString& Lhs, const TString& Rhs)
+{
+    return (Lhs._compare(Rhs) >= 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int TString::_compare(const TString& Rhs) const
+{
+    const size_t Len = _strLen < Rhs._strLen ? _strLen : Rhs._strLen;
+
+    if (Len != 0 && _str != Rhs._str)
+    {
+        int Diff = ::memcmp(_str, Rhs._str, Len);
+        if (Diff != 0)
+            return (Diff);
+    }
+    if (_strLen == Rhs._strLen)
+        return (0);
+    return (_strLen < Rhs._strLen ? -1 : 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const char& TString::operator[](sizeType Index) const
+{
+    return (*(_str + Index));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+char& TString::operator[](sizeType Index)
+{
+    return (*(_str + Index));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const char& TString::At(sizeType Index) const
+{
+    if (_strLen <= Index)
+        throw;
+    return (operator[](Index));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+char& TString::At(sizeType Index)
+{
+    if (_strLen <= Index)
+        throw;
+    return (operator[](Index));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const char& TString::Front(void) const
+{
+    return (operator[](0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+char& TString::Front(void)
+{
+    return (operator[](0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const char& TString::Back(void) const
+{
+    return (operator[](_strLen - 1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+char& TString::Back(void)
+{
+    return (operator[](_strLen - 1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::operator+=(const TString& Other)
+{
+    _append(Other._str, Other._strLen);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::operator+=(const char* Other)
+{
+    _append(Other);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::operator+=(char Ch)
+{
+    _append(&Ch, 1);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Append(const TString& Str)
+{
+    _append(Str._str, Str._strLen);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Append(const TString& Str, sizeType SubPos, size_t SubLen)
+{
+    char* Buffer = nullptr;
+
+    SubLen = _getLength(Str, SubPos, SubLen);
+    _substr(Buffer, Str._str, SubPos, SubLen);
+    _append(Buffer, SubLen);
+    SafeDelete(Buffer);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Append(const char* Str)
+{
+    _append(Str);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Append(const char* Str, size_t Len)
+{
+    char* Buffer = nullptr;
+
+    _substr(Buffer, Str, 0, Len);
+    _append(Buffer, Len);
+    SafeDelete(Buffer);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Append(sizeType Len, char Filler)
+{
+    char* Buffer = nullptr;
+
+    _allocCString(Buffer, Len, Filler);
+    _append(Buffer, Len);
+    SafeDelete(Buffer);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Append(const ConstIterator First, const ConstIterator Second)
+{
+    const size_t Len = _getLength(First, Second);
+
+    if (Len != 0)
+    {
+        char* Buffer = nullptr;
+        _allocCString(Buffer, Len, First, Second);
+        _append(Buffer, Len);
+        SafeDelete(Buffer);
+    }
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::PushBack(char Ch)
+{
+    _append(&Ch, 1);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Insert(sizeType Pos, const TString& Other)
+{
+    _insertstr(Pos, Other._str, Other._strLen);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Insert(sizeType Pos, const TString& Other, sizeType SubPos,
+    size_t SubLen)
+{
+    char* Buffer = nullptr;
+
+    SubLen = _getLength(Other, SubPos, SubLen);
+    _substr(Buffer, Other._str, SubPos, SubLen);
+    _insertstr(Pos, Buffer, SubLen);
+    SafeDelete(Buffer);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Insert(sizeType Pos, const char* Other)
+{
+    _insertstr(Pos, Other);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Insert(sizeType Pos, const char* Other, size_t Len)
+{
+    char* Buffer = nullptr;
+
+    _substr(Buffer, Other, 0, Len);
+    _insertstr(Pos, Buffer, Len);
+    SafeDelete(Buffer);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Insert(sizeType Pos, size_t Len, char Filler)
+{
+    char* Buffer = nullptr;
+
+    _allocCString(Buffer, Len, Filler);
+    _insertstr(Pos, Buffer, Len);
+    SafeDelete(Buffer);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TString::Insert(Iterator Ptr, size_t Len, char Ch)
+{
+    char* Buffer = nullptr;
+
+    _allocCString(Buffer, Len, Ch);
+    _insertstr(Ptr.current.pos, Buffer, Len);
+    SafeDelete(Buffer);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::Iterator TString::Insert(Iterator Ptr, char Ch)
+{
+    _insertstr(Ptr.current.pos, &Ch, 1);
+    return (Ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TString::Insert(Iterator Ptr, const ConstIterator First,
+    const ConstIterator Second)
+{
+    const size_t Len = _getLength(First, Second);
+
+    if (Len == 0)
+    {
+        return;
+    }
+    char* Buffer = nullptr;
+    _allocCString(Buffer, Len, First, Second);
+    _insertstr(Ptr.current.pos, Buffer, Len);
+    SafeDelete(Buffer);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Erase(sizeType Pos, size_t Len)
+{
+    _erase(Pos, Len);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::Iterator TString::Erase(ConstIterator Ptr)
+{
+    _erase(Ptr.current.pos, 1);
+    return (Ptr.current);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::Iterator TString::Erase(ConstIterator First, ConstIterator Last)
+{
+    _erase(First.current.pos, _getLength(First, Last));
+    return (First.current);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Replace(sizeType Pos, size_t Len, const TString& Other)
+{
+    _replace(Pos, Len, Other._str, Other._strLen);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Replace(ConstIterator It1, ConstIterator It2,
+    const TString& Other)
+{
+    Replace(It1.current.pos, _getLength(It1, It2), Other._str, Other._strLen);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Replace(sizeType Pos, size_t Len, const TString& Other,
+    sizeType SubPos, size_t SubLen)
+{
+    char* Buffer = nullptr;
+
+    SubLen = _getLength(Other, SubPos, SubLen);
+    _substr(Buffer, Other._str, SubPos, SubLen);
+    _replace(Pos, Len, Buffer, ::strlen(Buffer));
+    SafeDelete(Buffer);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Replace(sizeType Pos, size_t Len, const char* Str)
+{
+    _replace(Pos, Len, Str, ::strlen(Str));
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Replace(ConstIterator It1, ConstIterator It2,
+    const char* Other)
+{
+    _replace(It1.current.pos, _getLength(It1, It2), Other,
+        ::strlen(Other));
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Replace(sizeType Pos, size_t Len, const char* Other, size_t n)
+{
+    _replace(Pos, Len, Other, n);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString::TString(const TString& Other)
+TString& TString::Replace(ConstIterator It1, ConstIterator It2,
+    const char* Other, size_t n)
 {
-    _append(Other._str, Other._strLen);
+    _replace(It1.current.pos, _getLength(It1, It2), Other, n);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString::TString(const TString& Other, sizeType Pos, size_t Len)
+TString& TString::Replace(sizeType Pos, size_t Len, size_t n, char Filler)
+{
+    char* Buffer = nullptr;
+
+    _allocCString(Buffer, n, Filler);
+    _replace(Pos, Len, Buffer, n);
+    SafeDelete(Buffer);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::Replace(ConstIterator It1, ConstIterator It2, sizeType n,
+    char Ch)
 {
-    Append(Other._str, Pos, Len);
+    char* Buffer = nullptr;
+
+    _allocCString(Buffer, n, Ch);
+    _replace(It1.current.pos, _getLength(It1, It2), Buffer, n);
+    SafeDelete(Buffer);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString::TString(TString&& Other)
+TString& TString::Replace(ConstIterator It1, ConstIterator It2,
+    ConstIterator First, ConstIterator Second)
+{
+    const size_t Len = _getLength(First, Second);
+    char* Buffer = nullptr;
+
+    _allocCString(Buffer, Len, First, Second);
+    _replace(It1.current.pos, _getLength(It1, It2), Buffer, Len);
+    SafeDelete(Buffer);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::ReplaceAll(const TString& From, const TString& To)
+{
+    _replaceAll(From._str, From._strLen, To._str, To._strLen);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::ReplaceAll(const char* From, const char* To)
+{
+    _replaceAll(From, ::strlen(From), To, ::strlen(To));
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::ReplaceAll(char From, char To)
+{
+    sizeType i = 0;
+
+    if (From == To)
+        return (*this);
+#if defined(__SSE2__)
+    const __m128i Needle = _mm_set1_epi8(From);
+    const __m128i Filler = _mm_set1_epi8(To);
+    for (; i + 16 <= _strLen; i += 16)
+    {
+        const __m128i Block = _mm_loadu_si128((const __m128i*)(_str + i));
+        const __m128i Equal = _mm_cmpeq_epi8(Block, Needle);
+        if (_mm_movemask_epi8(Equal) == 0)
+            continue;
+        _mm_storeu_si128((__m128i*)(_str + i), _mm_or_si128(
+            _mm_andnot_si128(Equal, Block), _mm_and_si128(Equal, Filler)));
+    }
+#endif
+    for (; i < _strLen; ++i)
+    {
+        if (_str[i] == From)
+            _str[i] = To;
+    }
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TString::Swap(TString& Other)
 {
+    TString temp = std::move(*this);
     *this = std::move(Other);
+    Other = std::move(temp);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString::TString(const char* Other)
+TString& TString::PopBack(void)
 {
-    _append(Other);
+    _erase((End() - 1).current.pos, 1);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString::TString(const char* Other, size_t Len)
+inline void TString::_append(const char* Other)
 {
-    Append(Other, 0, Len);
+    return (_append(Other, ::strlen(Other)));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString::TString(size_t Len, char Filler)
+void TString::_append(const char* Other, size_t Len)
 {
-    Append(Len, Filler);
+    if (!Other || Len == 0)
+        return;
+    _increaseCapacity(_strLen + Len);
+    sizeType i = 0;
+    for (; i < Len; ++i)
+        operator[](_strLen + i) = Other[i];
+    operator[](_strLen + i) = '\0';
+    _setLength(_strLen + Len);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString::TString(const ConstIterator First, const ConstIterator Second)
+void TString::_insertstr(sizeType Pos, const char* Other)
 {
-    Append(First, Second);
+    if (Other != nullptr)
+        _insertstr(Pos, Other, ::strlen(Other));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::operator=(const TString& Other)
+void TString::_insertstr(sizeType Pos, const char* Other, size_t Len)
 {
-    if (this != &Other)
+    if (Pos == _strLen)
+        return (_append(Other, Len));
+    if (Pos > _strLen)
+        throw;
+    if (Len == 0)
+        return;
+    _increaseCapacity(_strLen + Len);
+    if (_str)
     {
-        _setLength(0);
-        _append(Other._str, Other._strLen);
+        char* Buffer = nullptr;
+        _substr(Buffer, _str, Pos, _strLen - Pos);
+        _clearStr(Pos);
+        _append(Other, Len);
+        _append(Buffer, ::strlen(Buffer));
+        SafeDelete(Buffer);
     }
-    return (*this);
+    else _append(Other, Len);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::operator=(TString&& Other)
+void TString::_substr(char*& Buffer, const char* Other, sizeType Pos,
+    size_t Len) const
 {
-    if (this != &Other)
+    if (Other == nullptr)
+        throw;
+    _allocCString(Buffer, Len);
+    for (sizeType i = 0; i < Len; ++i)
     {
-        SafeDeleteArray(_str);
-        _str = Other._str;
-        _strLen = Other._strLen;
-        _strCap = Other._strCap;
-        Other._str = nullptr;
-        Other._strLen = 0;
-        Other._strCap = 0;
+        Buffer[i] = Other[Pos + i];
     }
-    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString::~TString(void)
+void TString::_erase(sizeType Pos, size_t Len)
+{
+    Len = _getLength(*this, Pos, Len);
+    for (size_t i = Pos + Len; i < _strLen; ++i)
+    {
+        operator[](i - Len) = operator[](i);
+    }
+    _clearStr(_strLen - Len);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TString::_replace(sizeType Pos, size_t Len, const char* Other, size_t n)
 {
+    char* Buffer = nullptr;
+    char* RBuffer = nullptr;
+
+    Len = _getLength(*this, Pos, Len);
+    _substr(Buffer, _str, Pos + Len, _strLen - Pos - Len);
+    _clearStr(Pos);
+    _substr(RBuffer, Other, 0, n);
+    _append(RBuffer);
+    _append(Buffer);
+    SafeDelete(Buffer);
+    SafeDelete(RBuffer);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TString::_replaceAll(const char* From, size_t FromLen, const char* To,
+    size_t ToLen)
+{
+    if (FromLen == 0 || FromLen > _strLen)
+        return;
+    if (ToLen && To < _str + _strCap + 1 && _str < To + ToLen)
+    {
+        TString Copy;
+        Copy._append(To, ToLen);
+        return (_replaceAll(From, FromLen, Copy._str, ToLen));
+    }
+
+    // The result is never longer: compact it in place, the write cursor
+    // always stays behind the read cursor.
+    if (ToLen <= FromLen)
+    {
+        sizeType Read = 0;
+        char* Write = _str;
+        const char* Found = nullptr;
+
+        while ((Found = _searchBytes(_str + Read, _strLen - Read, From,
+            FromLen)) != nullptr)
+        {
+            const size_t Span = Found - (_str + Read);
+            ::memmove(Write, _str + Read, Span);
+            Write += Span;
+            ::memcpy(Write, To, ToLen);
+            Write += ToLen;
+            Read += Span + FromLen;
+        }
+        if (Write == _str + Read)
+            return;
+        ::memmove(Write, _str + Read, _strLen - Read);
+        _clearStr((Write - _str) + (_strLen - Read));
+        return;
+    }
+
+    std::vector<sizeType> Positions;
+    const size_t Count = _findAll(From, FromLen, 0, &Positions);
+    if (Count == 0)
+        return;
+
+    const size_t NewLen = _strLen + Count * (ToLen - FromLen);
+    char* Buffer = nullptr;
+    char* Write = nullptr;
+    sizeType Read = 0;
+
+    _allocCString(Buffer, NewLen);
+    Write = Buffer;
+    for (sizeType Pos : Positions)
+    {
+        ::memcpy(Write, _str + Read, Pos - Read);
+        Write += Pos - Read;
+        ::memcpy(Write, To, ToLen);
+        Write += ToLen;
+        Read = Pos + FromLen;
+    }
+    ::memcpy(Write, _str + Read, _strLen - Read);
     SafeDeleteArray(_str);
-    _strLen = 0;
-    _strCap = 0;
-    _increaseBy = 0;
+    _str = Buffer;
+    _strLen = NewLen;
+    _strCap = NewLen;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-bool operator==(const TString& Lhs, const TString& Rhs)
+size_t TString::_getLength(const TString& Str, sizeType Pos, size_t Len) const
 {
-    return (Lhs._compare(Rhs) == 0);
+    if (Len == npos)
+        Len = _strLen - Pos;
+    if (Pos + Len > Str._strLen)
+        throw;
+    return (Len);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-bool operator!=(const TString& Lhs, const TString& Rhs)
+const char* TString::CStr(void) const
 {
-    return (Lhs._compare(Rhs) != 0);
+    return (_str);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-bool operator<(const TString& Lhs, const TString& Rhs)
+size_t TString::Copy(char* Str, size_t Len, sizeType Pos) const
 {
-    return (Lhs._compare(Rhs) < 0);
+    if (!Str)
+        throw;
+    Len = _getLength(*this, Pos, Len);
+    for (sizeType i = 0; i < Len; ++i)
+        *(Str + i) = operator[](Pos + i);
+    return (Len);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-bool operator>(const TString& Lhs, const TString& Rhs)
+size_t TString::Find(const TString& Other, sizeType Pos) const
 {
-    return (Lhs._compare(Rhs) > 0);
+    return (_find(Other._str, Other._strLen, Pos));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-bool operator<=(const TString& Lhs, const TString& Rhs)
+size_t TString::Find(const char* Other, sizeType Pos) const
 {
-    return (Lhs._compare(Rhs) <= 0);
+    return (_find(Other, ::strlen(Other), Pos));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-bool operator>=(const TString& Lhs, const TString& Rhs)
+size_t TString::Find(const char* Other, sizeType Pos, sizeType n) const
 {
-    return (Lhs._compare(Rhs) >= 0);
+    return (_find(Other, n, Pos));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-int TString::_compare(const TString& Rhs) const
+size_t TString::Find(char Ch, sizeType Pos) const
 {
-    if (_strLen < Rhs._strLen)
-        return (1);
-    else if (_strLen > Rhs._strLen)
-        return (-1);
-    return (::strcmp(_str, Rhs._str));
+    return (_find(&Ch, 1, Pos));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-const char& TString::operator[](sizeType Index) const
+size_t TString::RFind(const TString& Other, sizeType Pos) const
 {
-    return (*(_str + Index));
+    return (_rfind(Other._str, Other._strLen, Pos));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-char& TString::operator[](sizeType Index)
+size_t TString::RFind(const char* Other, sizeType Pos) const
 {
-    return (*(_str + Index));
+    return (_rfind(Other, ::strlen(Other), Pos));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-const char& TString::At(sizeType Index) const
+size_t TString::RFind(const char* Other, sizeType Pos, size_t n) const
 {
-    if (_strLen <= Index)
-        throw;
-    return (operator[](Index));
+    return (_rfind(Other, n, Pos));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t TString::RFind(char Ch, sizeType Pos) const
+{
+    return (_rfind(&Ch, 1, Pos));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t TString::FindFirstOf(const TString& Other, sizeType Pos) const
+{
+    return (_findFirstOf(Other._str, Other._strLen, Pos, true));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t TString::FindFirstOf(const char* Other, sizeType Pos) const
+{
+    return (_findFirstOf(Other, ::strlen(Other), Pos, true));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t TString::FindFirstOf(const char* Other, sizeType Pos, size_t n) const
+{
+    return (_findFirstOf(Other, n, Pos, true));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t TString::FindFirstOf(char Ch, sizeType Pos) const
+{
+    return (_findFirstOf(&Ch, 1, Pos, true));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-char& TString::At(sizeType Index)
+size_t TString::FindLastOf(const TString& Other, sizeType Pos) const
 {
-    if (_strLen <= Index)
-        throw;
-    return (operator[](Index));
+    return (_findLastOf(Other._str, Other._strLen, Pos, true));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-const char& TString::Front(void) const
+size_t TString::FindLastOf(const char* Other, sizeType Pos) const
 {
-    return (operator[](0));
+    return (_findLastOf(Other, ::strlen(Other), Pos, true));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-char& TString::Front(void)
+size_t TString::FindLastOf(const char* Other, sizeType Pos, size_t n) const
 {
-    return (operator[](0));
+    return (_findLastOf(Other, n, Pos, true));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-const char& TString::Back(void) const
+size_t TString::FindLastOf(char Ch, sizeType Pos) const
 {
-    return (operator[](_strLen - 1));
+    return (_findLastOf(&Ch, 1, Pos, true));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-char& TString::Back(void)
+size_t TString::FindFirstNotOf(const TString& Other, sizeType Pos) const
 {
-    return (operator[](_strLen - 1));
+    return (_findFirstOf(Other._str, Other._strLen, Pos, false));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::operator+=(const TString& Other)
+size_t TString::FindFirstNotOf(const char* Other, sizeType Pos) const
 {
-    _append(Other._str, Other._strLen);
-    return (*this);
+    return (_findFirstOf(Other, ::strlen(Other), Pos, false));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::operator+=(const char* Other)
+size_t TString::FindFirstNotOf(const char* Other, sizeType Pos, size_t n) const
 {
-    _append(Other);
-    return (*this);
+    return (_findFirstOf(Other, n, Pos, false));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::operator+=(char Ch)
+size_t TString::FindFirstNotOf(char Ch, sizeType Pos) const
 {
-    _append(&Ch, 1);
-    return (*this);
+    return (_findFirstOf(&Ch, 1, Pos, false));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Append(const TString& Str)
+size_t TString::FindLastNotOf(const TString& Other, sizeType Pos) const
 {
-    _append(Str._str, Str._strLen);
-    return (*this);
+    return (_findLastOf(Other._str, Other._strLen, Pos, false));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Append(const TString& Str, sizeType SubPos, size_t SubLen)
+size_t TString::FindLastNotOf(const char* Other, sizeType Pos) const
 {
-    char* Buffer = nullptr;
-
-    SubLen = _getLength(Str, SubPos, SubLen);
-    _substr(Buffer, Str._str, SubPos, SubLen);
-    _append(Buffer, SubLen);
-    SafeDelete(Buffer);
-    return (*this);
+    return (_findLastOf(Other, ::strlen(Other), Pos, false));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Append(const char* Str)
+size_t TString::FindLastNotOf(const char* Other, sizeType Pos, size_t n) const
 {
-    _append(Str);
-    return (*this);
+    return (_findLastOf(Other, n, Pos, false));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Append(const char* Str, size_t Len)
+size_t TString::FindLastNotOf(char Ch, sizeType Pos) const
 {
-    char* Buffer = nullptr;
-
-    _substr(Buffer, Str, 0, Len);
-    _append(Buffer, Len);
-    SafeDelete(Buffer);
-    return (*this);
+    return (_findLastOf(&Ch, 1, Pos, false));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Append(sizeType Len, char Filler)
+std::vector<sizeType> TString::FindAll(const TString& Other, sizeType Pos) const
 {
-    char* Buffer = nullptr;
+    std::vector<sizeType> Positions;
 
-    _allocCString(Buffer, Len, Filler);
-    _append(Buffer, Len);
-    SafeDelete(Buffer);
-    return (*this);
+    _findAll(Other._str, Other._strLen, Pos, &Positions);
+    return (Positions);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Append(const ConstIterator First, const ConstIterator Second)
+std::vector<sizeType> TString::FindAll(const char* Other, sizeType Pos) const
 {
-    const size_t Len = _getLength(First, Second);
+    std::vector<sizeType> Positions;
 
-    if (Len != 0)
-    {
-        char* Buffer = nullptr;
-        _allocCString(Buffer, Len, First, Second);
-        _append(Buffer, Len);
-        SafeDelete(Buffer);
-    }
-    return (*this);
+    _findAll(Other, ::strlen(Other), Pos, &Positions);
+    return (Positions);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::PushBack(char Ch)
+std::vector<sizeType> TString::FindAll(char Ch, sizeType Pos) const
 {
-    _append(&Ch, 1);
-    return (*this);
+    std::vector<sizeType> Positions;
+
+    if (Pos < _strLen)
+        Positions.reserve(_countByte(_str + Pos, _strLen - Pos, Ch));
+    _findAll(&Ch, 1, Pos, &Positions);
+    return (Positions);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Insert(sizeType Pos, const TString& Other)
+size_t TString::Count(const TString& Other, sizeType Pos) const
 {
-    _insertstr(Pos, Other._str, Other._strLen);
-    return (*this);
+    return (_findAll(Other._str, Other._strLen, Pos, nullptr));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Insert(sizeType Pos, const TString& Other, sizeType SubPos,
-    size_t SubLen)
+size_t TString::Count(const char* Other, sizeType Pos) const
 {
-    char* Buffer = nullptr;
-
-    SubLen = _getLength(Other, SubPos, SubLen);
-    _substr(Buffer, Other._str, SubPos, SubLen);
-    _insertstr(Pos, Buffer, SubLen);
-    SafeDelete(Buffer);
-    return (*this);
+    return (_findAll(Other, ::strlen(Other), Pos, nullptr));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Insert(sizeType Pos, const char* Other)
+size_t TString::Count(char Ch, sizeType Pos) const
 {
-    _insertstr(Pos, Other);
-    return (*this);
+    if (Pos >= _strLen)
+        return (0);
+    return (_countByte(_str + Pos, _strLen - Pos, Ch));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Insert(sizeType Pos, const char* Other, size_t Len)
+size_t TString::_parallelChunk(size_t Len, size_t& Threads) const
 {
-    char* Buffer = nullptr;
+    // Below this size, starting threads costs more than the scan itself.
+    static const size_t MinChunk = 1 << 20;
 
-    _substr(Buffer, Other, 0, Len);
-    _insertstr(Pos, Buffer, Len);
-    SafeDelete(Buffer);
-    return (*this);
+    if (Threads == 0)
+        Threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    if (Len == 0 || Threads < 2 || _strLen < Len || _strLen < 2 * MinChunk)
+        return (0);
+    // A few chunks per thread keep the load balanced and let a first match
+    // cancel most of the remaining work.
+    return (std::max(MinChunk, (_strLen - Len + 1) / (Threads * 8) + 1));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Insert(sizeType Pos, size_t Len, char Filler)
+size_t TString::ParallelFind(const TString& Other, size_t Threads) const
 {
-    char* Buffer = nullptr;
+    const size_t Len = Other._strLen;
+    const size_t Chunk = _parallelChunk(Len, Threads);
 
-    _allocCString(Buffer, Len, Filler);
-    _insertstr(Pos, Buffer, Len);
-    SafeDelete(Buffer);
-    return (*this);
-}
+    if (Chunk == 0)
+        return (_find(Other._str, Len, 0));
 
-///////////////////////////////////////////////////////////////////////////////
-void TString::Insert(Iterator Ptr, size_t Len, char Ch)
-{
-    char* Buffer = nullptr;
+    const size_t Starts = _strLen - Len + 1;
+    std::atomic<size_t> Best(npos);
+    _parallelFor((Starts + Chunk - 1) / Chunk, Threads, [&](size_t i)
+    {
+        const sizeType Begin = i * Chunk;
+        const size_t Span = std::min(Chunk, Starts - Begin) + Len - 1;
 
-    _allocCString(Buffer, Len, Ch);
-    _insertstr(Ptr.current.pos, Buffer, Len);
-    SafeDelete(Buffer);
+        if (Begin >= Best.load(std::memory_order_relaxed))
+            return;
+        const char* Found = _searchBytes(_str + Begin, Span, Other._str, Len);
+        if (!Found)
+            return;
+        size_t Pos = Found - _str;
+        size_t Current = Best.load();
+        while (Pos < Current && !Best.compare_exchange_weak(Current, Pos));
+    });
+    return (Best.load());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString::Iterator TString::Insert(Iterator Ptr, char Ch)
+TString::sizeType TString::_findBefore(const char* Other, size_t Len,
+    sizeType Pos, sizeType End) const
 {
-    _insertstr(Ptr.current.pos, &Ch, 1);
-    return (Ptr);
+    if (Pos >= End)
+        return (npos);
+
+    const char* Hit = _searchBytes(_str + Pos, End - Pos + Len - 1, Other, Len);
+    return (Hit ? static_cast<sizeType>(Hit - _str) : npos);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void TString::Insert(Iterator Ptr, const ConstIterator First,
-    const ConstIterator Second)
+std::vector<sizeType> TString::ParallelFindAll(const TString& Other,
+    size_t Threads) const
 {
-    const size_t Len = _getLength(First, Second);
+    const size_t Len = Other._strLen;
+    const size_t Chunk = _parallelChunk(Len, Threads);
+    std::vector<sizeType> Positions;
 
-    if (Len == 0)
+    if (Chunk == 0)
     {
-        return;
+        _findAll(Other._str, Len, 0, &Positions);
+        return (Positions);
     }
-    char* Buffer = nullptr;
-    _allocCString(Buffer, Len, First, Second);
-    _insertstr(Ptr.current.pos, Buffer, Len);
-    SafeDelete(Buffer);
-}
 
-///////////////////////////////////////////////////////////////////////////////
-TString& TString::Erase(sizeType Pos, size_t Len)
-{
-    _erase(Pos, Len);
-    return (*this);
+    // Every chunk keeps the occurrences a scan starting at its first
+    // position would report, so at most one per needle length.
+    const size_t Starts = _strLen - Len + 1;
+    std::vector<std::vector<sizeType>> Found((Starts + Chunk - 1) / Chunk);
+    _parallelFor(Found.size(), Threads, [&](size_t i)
+    {
+        const sizeType End = std::min(Starts, (i + 1) * Chunk);
+
+        for (sizeType Pos = _findBefore(Other._str, Len, i * Chunk, End);
+            Pos != npos; Pos = _findBefore(Other._str, Len, Pos + Len, End))
+            Found[i].push_back(Pos);
+    });
+
+    // A chunk entered past its first position is scanned again from there,
+    // until that scan reports an occurrence the chunk also has: from then
+    // on both report the same ones.
+    sizeType Next = 0;
+    for (size_t i = 0; i < Found.size(); ++i)
+    {
+        const sizeType End = std::min(Starts, (i + 1) * Chunk);
+        const std::vector<sizeType>& Chunked = Found[i];
+        sizeType Pos = Chunked.empty() ? npos : Chunked[0];
+        size_t k = 0;
+
+        if (Next > i * Chunk)
+            Pos = _findBefore(Other._str, Len, Next, End);
+        for (; Pos != npos; Pos = _findBefore(Other._str, Len, Pos + Len, End))
+        {
+            while (k < Chunked.size() && Chunked[k] < Pos)
+                ++k;
+            if (k < Chunked.size() && Chunked[k] == Pos)
+            {
+                Positions.insert(Positions.end(), Chunked.begin() + k,
+                    Chunked.end());
+                break;
+            }
+            Positions.push_back(Pos);
+        }
+        if (!Positions.empty())
+            Next = Positions.back() + Len;
+    }
+    return (Positions);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString::Iterator TString::Erase(ConstIterator Ptr)
+size_t TString::ParallelCount(const TString& Other, size_t Threads) const
 {
-    _erase(Ptr.current.pos, 1);
-    return (Ptr.current);
+    const size_t Len = Other._strLen;
+    const size_t Chunk = _parallelChunk(Len, Threads);
+
+    if (Chunk == 0)
+        return (_findAll(Other._str, Len, 0, nullptr));
+
+    // Each chunk is counted as a scan starting at its first position would,
+    // keeping its last occurrence to find where the next chunk is entered.
+    const size_t Starts = _strLen - Len + 1;
+    const size_t Chunks = (Starts + Chunk - 1) / Chunk;
+    std::vector<size_t> Counts(Chunks, 0);
+    std::vector<sizeType> Last(Chunks, 0);
+    _parallelFor(Chunks, Threads, [&](size_t i)
+    {
+        const sizeType Begin = i * Chunk;
+        const size_t Span = std::min(Chunk, Starts - Begin);
+
+        // A single byte never runs into the next chunk, so `Last` can stay 0.
+        if (Len == 1)
+        {
+            Counts[i] = _countByte(_str + Begin, Span, *Other._str);
+            return;
+        }
+        for (sizeType Pos = _findBefore(Other._str, Len, Begin, Begin + Span);
+            Pos != npos;
+            Pos = _findBefore(Other._str, Len, Pos + Len, Begin + Span))
+        {
+            ++Counts[i];
+            Last[i] = Pos;
+        }
+    });
+
+    // A chunk entered past its first position is counted again from there,
+    // alongside a scan from its first position, until both report the same
+    // occurrence; the rest of the chunk's count then holds.
+    size_t Total = 0;
+    sizeType Next = 0;
+    for (size_t i = 0; i < Chunks; ++i)
+    {
+        const sizeType Begin = i * Chunk;
+        const sizeType End = std::min(Starts, Begin + Chunk);
+
+        if (Next <= Begin)
+        {
+            Total += Counts[i];
+            if (Counts[i])
+                Next = Last[i] + Len;
+            continue;
+        }
+
+        sizeType Own = _findBefore(Other._str, Len, Begin, End);
+        size_t Skipped = 0;
+        for (sizeType Pos = _findBefore(Other._str, Len, Next, End);
+            Pos != npos; Pos = _findBefore(Other._str, Len, Pos + Len, End))
+        {
+            while (Own != npos && Own < Pos)
+            {
+                Own = _findBefore(Other._str, Len, Own + Len, End);
+                ++Skipped;
+            }
+            if (Own == Pos)
+            {
+                Total += Counts[i] - Skipped;
+                Next = Last[i] + Len;
+                break;
+            }
+            ++Total;
+            Next = Pos + Len;
+        }
+    }
+    return (Total);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString::Iterator TString::Erase(ConstIterator First, ConstIterator Last)
+size_t TString::FindIgnoreCase(const TString& Other, sizeType Pos) const
 {
-    _erase(First.current.pos, _getLength(First, Last));
-    return (First.current);
+    const size_t Len = Other._strLen;
+
+    if (Pos > _strLen || Len > _strLen - Pos)
+        return (npos);
+    if (Len == 0)
+        return (Pos);
+
+    const char* Found =
+        _searchBytesFold(_str + Pos, _strLen - Pos, Other._str, Len);
+    return (Found ? static_cast<size_t>(Found - _str) : npos);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Replace(sizeType Pos, size_t Len, const TString& Other)
+size_t TString::FindIgnoreCase(const char* Other, sizeType Pos) const
 {
-    _replace(Pos, Len, Other._str, Other._strLen);
-    return (*this);
+    const size_t Len = ::strlen(Other);
+
+    if (Pos > _strLen || Len > _strLen - Pos)
+        return (npos);
+    if (Len == 0)
+        return (Pos);
+
+    const char* Found = _searchBytesFold(_str + Pos, _strLen - Pos, Other, Len);
+    return (Found ? static_cast<size_t>(Found - _str) : npos);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Replace(ConstIterator It1, ConstIterator It2,
-    const TString& Other)
+bool TString::EqualsIgnoreCase(const TString& Other) const
 {
-    Replace(It1.current.pos, _getLength(It1, It2), Other._str, Other._strLen);
-    return (*this);
+    if (_strLen != Other._strLen)
+        return (false);
+    if (_str == Other._str || _strLen == 0)
+        return (true);
+    return (_mismatchFold(_str, Other._str, _strLen) == _strLen);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Replace(sizeType Pos, size_t Len, const TString& Other,
-    sizeType SubPos, size_t SubLen)
+bool TString::EqualsIgnoreCase(const char* Other) const
 {
-    char* Buffer = nullptr;
+    const size_t Len = ::strlen(Other);
 
-    SubLen = _getLength(Other, SubPos, SubLen);
-    _substr(Buffer, Other._str, SubPos, SubLen);
-    _replace(Pos, Len, Buffer, ::strlen(Buffer));
-    SafeDelete(Buffer);
-    return (*this);
+    if (_strLen != Len)
+        return (false);
+    return (Len == 0 || _mismatchFold(_str, Other, Len) == Len);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Replace(sizeType Pos, size_t Len, const char* Str)
+int TString::CompareIgnoreCase(const TString& Other) const
 {
-    _replace(Pos, Len, Str, ::strlen(Str));
-    return (*this);
-}
+    const size_t Len = _strLen < Other._strLen ? _strLen : Other._strLen;
+    const size_t At = Len ? _mismatchFold(_str, Other._str, Len) : 0;
 
-///////////////////////////////////////////////////////////////////////////////
-TString& TString::Replace(ConstIterator It1, ConstIterator It2,
-    const char* Other)
-{
-    _replace(It1.current.pos, _getLength(It1, It2), Other,
-        ::strlen(Other));
-    return (*this);
+    if (At < Len)
+    {
+        return (_foldAscii(static_cast<unsigned char>(_str[At])) -
+            _foldAscii(static_cast<unsigned char>(Other._str[At])));
+    }
+    if (_strLen == Other._strLen)
+        return (0);
+    return (_strLen < Other._strLen ? -1 : 1);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Replace(sizeType Pos, size_t Len, const char* Other, size_t n)
+bool TString::StartsWithIgnoreCase(const TString& Prefix) const
 {
-    _replace(Pos, Len, Other, n);
-    return (*this);
+    if (Prefix._strLen > _strLen)
+        return (false);
+    return (Prefix._strLen == 0 ||
+        _mismatchFold(_str, Prefix._str, Prefix._strLen) == Prefix._strLen);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Replace(ConstIterator It1, ConstIterator It2,
-    const char* Other, size_t n)
+bool TString::StartsWithIgnoreCase(const char* Prefix) const
 {
-    _replace(It1.current.pos, _getLength(It1, It2), Other, n);
-    return (*this);
+    const size_t Len = ::strlen(Prefix);
+
+    if (Len > _strLen)
+        return (false);
+    return (Len == 0 || _mismatchFold(_str, Prefix, Len) == Len);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Replace(sizeType Pos, size_t Len, size_t n, char Filler)
+bool TString::IsValidUtf8(sizeType* ErrorOffset) const
 {
-    char* Buffer = nullptr;
-
-    _allocCString(Buffer, n, Filler);
-    _replace(Pos, Len, Buffer, n);
-    SafeDelete(Buffer);
-    return (*this);
+    return (ValidateUtf8(_str, _strLen, ErrorOffset));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Replace(ConstIterator It1, ConstIterator It2, sizeType n,
-    char Ch)
+bool TString::ValidateUtf8(const char* Data, size_t Len,
+    sizeType* ErrorOffset)
 {
-    char* Buffer = nullptr;
+    const size_t At = Len ? _validateUtf8(Data, Len) : 0;
 
-    _allocCString(Buffer, n, Ch);
-    _replace(It1.current.pos, _getLength(It1, It2), Buffer, n);
-    SafeDelete(Buffer);
-    return (*this);
+    if (ErrorOffset)
+        *ErrorOffset = At == Len ? npos : At;
+    return (At == Len);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::Replace(ConstIterator It1, ConstIterator It2,
-    ConstIterator First, ConstIterator Second)
+bool TString::AppendUtf8(const char* Data, size_t Len, sizeType* ErrorOffset)
 {
-    const size_t Len = _getLength(First, Second);
-    char* Buffer = nullptr;
-
-    _allocCString(Buffer, Len, First, Second);
-    _replace(It1.current.pos, _getLength(It1, It2), Buffer, Len);
-    SafeDelete(Buffer);
-    return (*this);
+    if (!ValidateUtf8(Data, Len, ErrorOffset))
+        return (false);
+    _append(Data, Len);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void TString::Swap(TString& Other)
+bool TString::FromUtf8(const char* Data, size_t Len, TString& Out,
+    sizeType* ErrorOffset)
 {
-    TString temp = std::move(*this);
-    *this = std::move(Other);
-    Other = std::move(temp);
+    TString Result;
+
+    if (!Result.AppendUtf8(Data, Len, ErrorOffset))
+        return (false);
+    Out.Swap(Result);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-TString& TString::PopBack(void)
+TString::sizeType TString::CodePointCount(void) const
 {
-    _erase((End() - 1).current.pos, 1);
-    return (*this);
+    return (_countLeads(_str, _strLen));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-inline void TString::_append(const char* Other)
+TString::sizeType TString::CodePointIndex(sizeType Offset) const
 {
-    return (_append(Other, ::strlen(Other)));
+    if (Offset > _strLen)
+        return (npos);
+    return (_countLeads(_str, Offset));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void TString::_append(const char* Other, size_t Len)
-{
-    if (!Other || Len == 0)
-        return;
-    _increaseCapacity(_strLen + Len);
-    sizeType i = 0;
-    for (; i < Len; ++i)
-        operator[](_strLen + i) = Other[i];
-    operator[](_strLen + i) = '\0';
-    _setLength(_strLen + Len);
+TString::sizeType TString::ByteOffset(sizeType Index) const
+{
+    return (_nthLead(_str, _strLen, Index));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void TString::_insertstr(sizeType Pos, const char* Other)
+TString::CodePointIterator TString::CodePointBegin(void) const
 {
-    if (Other != nullptr)
-        _insertstr(Pos, Other, ::strlen(Other));
+    return (CodePointIterator(_str, _strLen, 0));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void TString::_insertstr(sizeType Pos, const char* Other, size_t Len)
+TString::CodePointIterator TString::CodePointEnd(void) const
 {
-    if (Pos == _strLen)
-        return (_append(Other, Len));
-    if (Pos > _strLen)
-        throw;
-    if (Len == 0)
-        return;
-    _increaseCapacity(_strLen + Len);
-    if (_str)
-    {
-        char* Buffer = nullptr;
-        _substr(Buffer, _str, Pos, _strLen);
-        _clearStr(Pos);
-        _append(Other, Len);
-        _append(Buffer, ::strlen(Buffer));
-        SafeDelete(Buffer);
-    }
-    else _append(Other, Len);
+    return (CodePointIterator(_str, _strLen, _strLen));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void TString::_substr(char*& Buffer, const char* Other, sizeType Pos,
-    size_t Len) const
+bool TString::ToUtf16(std::u16string& Out) const
 {
-    if (Other == nullptr)
-        throw;
-    _allocCString(Buffer, Len);
-    for (sizeType i = 0; i < _strLen; ++i)
-    {
-        Buffer[i] = Other[Pos + i];
-    }
+    std::u16string Result(_strLen, u'\0');
+
+    if (!IsValidUtf8())
+        return (false);
+    Result.resize(_utf8To(_str, _strLen, &Result[0]));
+    Out.swap(Result);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void TString::_erase(sizeType Pos, size_t Len)
+bool TString::ToUtf32(std::u32string& Out) const
 {
-    Len = _getLength(*this, Pos, Len);
-    for (size_t i = Pos + Len; i < _strLen; ++i)
-    {
-        operator[](i - Len) = operator[](i);
-    }
-    _clearStr(_strLen - Len);
+    std::u32string Result(_strLen, U'\0');
+
+    if (!IsValidUtf8())
+        return (false);
+    Result.resize(_utf8To(_str, _strLen, &Result[0]));
+    Out.swap(Result);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void TString::_replace(sizeType Pos, size_t Len, const char* Other, size_t n)
+template <typename T>
+bool TString::_fromUnits(const T* Data, size_t Len, TString& Out,
+    sizeType* ErrorOffset)
 {
+    TString Result;
     char* Buffer = nullptr;
-    char* RBuffer = nullptr;
+    size_t At = npos;
+    const size_t Size = _utf8Size(Data, Len, At);
+
+    if (ErrorOffset)
+        *ErrorOffset = At;
+    if (Size == npos)
+        return (false);
+    if (Size != 0)
+    {
+        Result._allocCString(Buffer, Size);
+        _utf8From(Data, Len, Buffer);
+        SafeDeleteArray(Result._str);
+        Result._str = Buffer;
+        Result._strLen = Size;
+        Result._strCap = Size;
+    }
+    Out.Swap(Result);
+    return (true);
+}
 
-    Len = _getLength(*this, Pos, Len);
-    _substr(Buffer, _str, Pos + Len, _strLen);
-    _clearStr(Pos);
-    _substr(RBuffer, Other, 0, n);
-    _append(RBuffer);
-    _append(Buffer);
-    SafeDelete(Buffer);
-    SafeDelete(RBuffer);
+///////////////////////////////////////////////////////////////////////////////
+bool TString::FromUtf16(const char16_t* Data, size_t Len, TString& Out,
+    sizeType* ErrorOffset)
+{
+    return (_fromUnits(Data, Len, Out, ErrorOffset));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::_getLength(const TString& Str, sizeType Pos, size_t Len) const
+bool TString::FromUtf32(const char32_t* Data, size_t Len, TString& Out,
+    sizeType* ErrorOffset)
 {
-    if (Len == npos)
-        Len = _strLen - Pos;
-    if (Pos + Len > Str._strLen)
-        throw;
-    return (Len);
+    return (_fromUnits(Data, Len, Out, ErrorOffset));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-const char* TString::CStr(void) const
+TString TString::ToBase64(Base64Alphabet Alphabet, bool Padding) const
 {
-    return (_str);
+    TString Result(_base64Size(_strLen, Padding), ReserveTag());
+
+    Result.AppendBase64(_str, _strLen, Alphabet, Padding);
+    return (Result);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::Copy(char* Str, size_t Len, sizeType Pos) const
+bool TString::FromBase64(const char* Data, size_t Len, TString& Out,
+    Base64Alphabet Alphabet, sizeType* ErrorOffset)
 {
-    if (!Str)
-        throw;
-    Len = _getLength(*this, Pos, Len);
-    for (sizeType i = 0; i < Len; ++i)
-        *(Str + i) = operator[](Pos + i);
-    return (Len);
+    TString Result;
+
+    if (!Result.AppendFromBase64(Data, Len, Alphabet, ErrorOffset))
+        return (false);
+    Out.Swap(Result);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::Find(const TString& Other, sizeType Pos) const
+TString& TString::AppendBase64(const char* Data, size_t Len,
+    Base64Alphabet Alphabet, bool Padding)
 {
-    return (_find(Other._str, Other._strLen, Pos));
+    const unsigned char* Src = reinterpret_cast<const unsigned char*>(Data);
+    const bool Url = Alphabet == Base64Alphabet::Url;
+    const size_t Whole = Len / 3 * 3;
+    const size_t Rest = Len - Whole;
+    const size_t Size = _base64Size(Len, Padding);
+    char Last[4];
+
+    if (Size == 0)
+        return (*this);
+    char* Dst = _reserveTail(Size);
+    _base64Encode(Src, Whole, Dst, Url);
+    if (Rest)
+        ::memcpy(Dst + Whole / 3 * 4, Last,
+            _base64EncodeTail(Src + Whole, Rest, Last, Url, Padding));
+    _commitTail(Size);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::Find(const char* Other, sizeType Pos) const
+bool TString::AppendFromBase64(const char* Data, size_t Len,
+    Base64Alphabet Alphabet, sizeType* ErrorOffset)
 {
-    return (_find(Other, ::strlen(Other), Pos));
+    const signed char* Values = _base64Values(Alphabet == Base64Alphabet::Url);
+    size_t Pad = 0;
+
+    if (Len % 4 == 0 && Len > 0 && Data[Len - 1] == '=')
+        Pad = Data[Len - 2] == '=' ? 2 : 1;
+
+    const size_t Digits = Len - Pad;
+    const size_t Whole = Digits / 4 * 4;
+    const size_t Rest = Digits - Whole;
+    const size_t Size = Whole / 4 * 3 + (Rest ? Rest - 1 : 0);
+    size_t At = Len;
+    uint32_t Group = 0;
+
+    for (size_t i = Whole; i < Digits && At == Len; ++i)
+    {
+        const int Value = Values[static_cast<unsigned char>(Data[i])];
+        if (Value < 0)
+            At = i;
+        Group |= static_cast<uint32_t>(Value) << (18 - 6 * (i - Whole));
+    }
+    if (At == Len && (Rest == 1 || (Group & (Rest == 2 ? 0xFFFF : 0xFF))))
+        At = Digits - 1;
+
+    unsigned char* Dst = reinterpret_cast<unsigned char*>(_reserveTail(Size));
+    const size_t Bad = _base64Decode(Data, Whole, Dst,
+        Alphabet == Base64Alphabet::Url, Size);
+    if (Bad != Whole)
+        At = Bad;
+    if (ErrorOffset)
+        *ErrorOffset = At == Len ? npos : At;
+    if (At != Len)
+    {
+        if (_str)
+            _str[_strLen] = '\0';
+        return (false);
+    }
+    for (size_t k = 0; k + 1 < Rest; ++k)
+        Dst[Whole / 4 * 3 + k] = static_cast<unsigned char>(Group >> (16 - 8 * k));
+    _commitTail(Size);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::Find(const char* Other, sizeType Pos, sizeType n) const
+TString TString::ToHex(bool Upper) const
 {
-    return (_find(Other, n, Pos));
+    TString Result(_strLen * 2, ReserveTag());
+
+    Result.AppendHex(_str, _strLen, Upper);
+    return (Result);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::Find(char Ch, sizeType Pos) const
+bool TString::FromHex(const char* Data, size_t Len, TString& Out,
+    sizeType* ErrorOffset)
 {
-    return (_find(&Ch, 1, Pos));
+    TString Result;
+
+    if (!Result.AppendFromHex(Data, Len, ErrorOffset))
+        return (false);
+    Out.Swap(Result);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::RFind(const TString& Other, sizeType Pos) const
+TString& TString::AppendHex(const char* Data, size_t Len, bool Upper)
 {
-    return (_rfind(Other._str, Other._strLen, Pos));
+    if (Len == 0)
+        return (*this);
+    _hexEncode(reinterpret_cast<const unsigned char*>(Data), Len,
+        _reserveTail(Len * 2), Upper);
+    _commitTail(Len * 2);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::RFind(const char* Other, sizeType Pos) const
+bool TString::AppendFromHex(const char* Data, size_t Len,
+    sizeType* ErrorOffset)
 {
-    return (_rfind(Other, ::strlen(Other), Pos));
+    const size_t Whole = Len & ~size_t(1);
+    unsigned char* Dst =
+        reinterpret_cast<unsigned char*>(_reserveTail(Whole / 2));
+    size_t At = _hexDecode(Data, Whole, Dst);
+
+    if (At == Whole && Whole != Len)
+        At = Whole;
+    else if (At == Whole)
+        At = npos;
+    if (ErrorOffset)
+        *ErrorOffset = At;
+    if (At != npos)
+    {
+        _str[_strLen] = '\0';
+        return (false);
+    }
+    _commitTail(Whole / 2);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::RFind(const char* Other, sizeType Pos, size_t n) const
+TString TString::UrlEncode(UrlMode Mode) const
 {
-    return (_rfind(Other, n, Pos));
+    const ByteSet& Safe = _urlSafe(static_cast<int>(Mode));
+    const bool Form = Mode == UrlMode::Form;
+    const size_t Size = _urlEncodedSize(_str, _strLen, Safe, Form);
+    TString Result(Size, ReserveTag());
+
+    _urlEncode(_str, _strLen, Safe, Form, Result._str);
+    Result._commitTail(Size);
+    return (Result);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::RFind(char Ch, sizeType Pos) const
+bool TString::UrlDecode(const char* Data, size_t Len, TString& Out,
+    UrlMode Mode, sizeType* ErrorOffset)
 {
-    return (_rfind(&Ch, 1, Pos));
+    TString Result;
+
+    if (!Result.AppendUrlDecode(Data, Len, Mode, ErrorOffset))
+        return (false);
+    Out.Swap(Result);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindFirstOf(const TString& Other, sizeType Pos) const
+TString& TString::AppendUrlEncode(const char* Data, size_t Len, UrlMode Mode)
 {
-    return (_findFirstOf(Other._str, Other._strLen, Pos, true));
+    const ByteSet& Safe = _urlSafe(static_cast<int>(Mode));
+    const bool Form = Mode == UrlMode::Form;
+
+    // First pass sizes the output, so the string grows only once.
+    const size_t Size = _urlEncodedSize(Data, Len, Safe, Form);
+    if (Size == 0)
+        return (*this);
+    _urlEncode(Data, Len, Safe, Form, _reserveTail(Size));
+    _commitTail(Size);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindFirstOf(const char* Other, sizeType Pos) const
+bool TString::AppendUrlDecode(const char* Data, size_t Len, UrlMode Mode,
+    sizeType* ErrorOffset)
 {
-    return (_findFirstOf(Other, ::strlen(Other), Pos, true));
+    const bool Form = Mode == UrlMode::Form;
+    unsigned char Byte;
+    size_t Size = 0;
+
+    // First pass checks the escapes and sizes the output, so the string
+    // grows only once and is left alone on failure.
+    for (size_t i = 0; i < Len;)
+    {
+        const size_t Run = _urlPlainRun(Data + i, Len - i, Form);
+        i += Run;
+        Size += Run;
+        if (i == Len)
+            break;
+        if (Data[i] == '%' &&
+            (Len - i < 3 || _hexDecode(Data + i + 1, 2, &Byte) != 2))
+        {
+            if (ErrorOffset)
+                *ErrorOffset = i;
+            return (false);
+        }
+        i += Data[i] == '%' ? 3 : 1;
+        Size++;
+    }
+    if (ErrorOffset)
+        *ErrorOffset = npos;
+    if (Size == 0)
+        return (true);
+
+    char* Dst = _reserveTail(Size);
+    for (size_t i = 0; i < Len;)
+    {
+        const size_t Run = _urlPlainRun(Data + i, Len - i, Form);
+        ::memcpy(Dst, Data + i, Run);
+        Dst += Run;
+        i += Run;
+        if (i == Len)
+            break;
+        if (Data[i] == '+')
+        {
+            *Dst++ = ' ';
+            i++;
+            continue;
+        }
+        _hexDecode(Data + i + 1, 2, reinterpret_cast<unsigned char*>(Dst++));
+        i += 3;
+    }
+    _commitTail(Size);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindFirstOf(const char* Other, sizeType Pos, size_t n) const
+void TString::JsonEscapeAppend(TString& Dest) const
 {
-    return (_findFirstOf(Other, n, Pos, true));
+    static const char Digits[] = "0123456789abcdef";
+    size_t Size = 0;
+
+    if (&Dest == this)
+    {
+        TString Copy(*this);
+        Copy.JsonEscapeAppend(Dest);
+        return;
+    }
+
+    // First pass sizes the output, so the destination grows only once.
+    for (size_t i = 0; i < _strLen; ++i)
+    {
+        const size_t Run = _jsonPlainRun(_str + i, _strLen - i);
+        Size += Run;
+        i += Run;
+        if (i == _strLen)
+            break;
+        Size += _jsonShortEscape(static_cast<unsigned char>(_str[i])) ? 2 : 6;
+    }
+    if (Size == 0)
+        return;
+
+    char* Dst = Dest._reserveTail(Size);
+    for (size_t i = 0; i < _strLen; ++i)
+    {
+        const size_t Run = _jsonPlainRun(_str + i, _strLen - i);
+        ::memcpy(Dst, _str + i, Run);
+        Dst += Run;
+        i += Run;
+        if (i == _strLen)
+            break;
+
+        const unsigned char Ch = static_cast<unsigned char>(_str[i]);
+        const char Letter = _jsonShortEscape(Ch);
+        *Dst++ = '\\';
+        if (Letter)
+        {
+            *Dst++ = Letter;
+            continue;
+        }
+        ::memcpy(Dst, "u00", 3);
+        Dst[3] = Digits[Ch >> 4];
+        Dst[4] = Digits[Ch & 15];
+        Dst += 5;
+    }
+    Dest._commitTail(Size);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindFirstOf(char Ch, sizeType Pos) const
+bool TString::JsonUnescape(const char* Data, size_t Len, TString& Out,
+    sizeType* ErrorOffset)
 {
-    return (_findFirstOf(&Ch, 1, Pos, true));
+    TString Result;
+
+    if (!Result.AppendJsonUnescape(Data, Len, ErrorOffset))
+        return (false);
+    Out.Swap(Result);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindLastOf(const TString& Other, sizeType Pos) const
+bool TString::AppendJsonUnescape(const char* Data, size_t Len,
+    sizeType* ErrorOffset)
 {
-    return (_findLastOf(Other._str, Other._strLen, Pos, true));
+    size_t Size = 0;
+    size_t Escape = 0;
+    char Bytes[4];
+
+    // First pass checks the escapes and sizes the output, so the string
+    // grows only once and is left alone on failure.
+    for (size_t i = 0; i < Len; i += Escape)
+    {
+        const size_t Run = _jsonPlainRun(Data + i, Len - i);
+        Size += Run;
+        i += Run;
+        if (i == Len)
+            break;
+
+        const char32_t Code = Data[i] == '\\'
+            ? _jsonEscape(Data + i, Len - i, Escape) : char32_t(-1);
+        if (Code == char32_t(-1))
+        {
+            if (ErrorOffset)
+                *ErrorOffset = i;
+            return (false);
+        }
+        Size += _encodeUtf8(Code, Bytes);
+    }
+    if (ErrorOffset)
+        *ErrorOffset = npos;
+    if (Size == 0)
+        return (true);
+
+    char* Dst = _reserveTail(Size);
+    for (size_t i = 0; i < Len; i += Escape)
+    {
+        const size_t Run = _jsonPlainRun(Data + i, Len - i);
+        ::memcpy(Dst, Data + i, Run);
+        Dst += Run;
+        i += Run;
+        if (i == Len)
+            break;
+        Dst += _encodeUtf8(_jsonEscape(Data + i, Len - i, Escape), Dst);
+    }
+    _commitTail(Size);
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindLastOf(const char* Other, sizeType Pos) const
+TString& TString::AppendInt(int64_t Value)
 {
-    return (_findLastOf(Other, ::strlen(Other), Pos, true));
+    const uint64_t Magnitude = Value < 0
+        ? 0 - static_cast<uint64_t>(Value) : static_cast<uint64_t>(Value);
+    const size_t Len = _digitCount(Magnitude) + (Value < 0);
+
+    _increaseCapacity(_strLen + Len);
+    if (Value < 0)
+        _str[_strLen] = '-';
+    _writeDigits(_str + _strLen + Len, Magnitude);
+    _commitTail(Len);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindLastOf(const char* Other, sizeType Pos, size_t n) const
+TString& TString::AppendUInt(uint64_t Value)
 {
-    return (_findLastOf(Other, n, Pos, true));
+    const size_t Len = _digitCount(Value);
+
+    _increaseCapacity(_strLen + Len);
+    _writeDigits(_str + _strLen + Len, Value);
+    _commitTail(Len);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindLastOf(char Ch, sizeType Pos) const
+TString& TString::AppendDouble(double Value)
 {
-    return (_findLastOf(&Ch, 1, Pos, true));
+    static const size_t MaxLen = 24;
+
+    _increaseCapacity(_strLen + MaxLen);
+    char* Dst = _str + _strLen;
+    _commitTail(std::to_chars(Dst, Dst + MaxLen, Value).ptr - Dst);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindFirstNotOf(const TString& Other, sizeType Pos) const
+TString& TString::AppendFloat(float Value)
 {
-    return (_findFirstOf(Other._str, Other._strLen, Pos, false));
+    static const size_t MaxLen = 24;
+
+    _increaseCapacity(_strLen + MaxLen);
+    char* Dst = _str + _strLen;
+    _commitTail(std::to_chars(Dst, Dst + MaxLen, Value).ptr - Dst);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindFirstNotOf(const char* Other, sizeType Pos) const
+bool TString::IsAscii(void) const
 {
-    return (_findFirstOf(Other, ::strlen(Other), Pos, false));
+    sizeType i = 0;
+#if defined(__SSE2__)
+    for (; i + 64 <= _strLen; i += 64)
+    {
+        const __m128i A = _mm_loadu_si128((const __m128i*)(_str + i));
+        const __m128i B = _mm_loadu_si128((const __m128i*)(_str + i + 16));
+        const __m128i C = _mm_loadu_si128((const __m128i*)(_str + i + 32));
+        const __m128i D = _mm_loadu_si128((const __m128i*)(_str + i + 48));
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(A, B),
+            _mm_or_si128(C, D))))
+            return (false);
+    }
+    for (; i + 16 <= _strLen; i += 16)
+    {
+        if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(_str + i))))
+            return (false);
+    }
+#endif
+    for (; i < _strLen; ++i)
+    {
+        if (static_cast<unsigned char>(_str[i]) & 0x80)
+            return (false);
+    }
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindFirstNotOf(const char* Other, sizeType Pos, size_t n) const
+size_t TString::EditDistance(const TString& Other) const
 {
-    return (_findFirstOf(Other, n, Pos, false));
+    return (BoundedEditDistance(Other, npos - 1));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindFirstNotOf(char Ch, sizeType Pos) const
+size_t TString::BoundedEditDistance(const TString& Other, size_t K) const
 {
-    return (_findFirstOf(&Ch, 1, Pos, false));
+    const TString& Short = _strLen <= Other._strLen ? *this : Other;
+    const TString& Long = _strLen <= Other._strLen ? Other : *this;
+
+    if (Short._strLen == 0 || Long._strLen - Short._strLen > K)
+        return (Long._strLen <= K ? Long._strLen : npos);
+    return (_editDistance(_MyersPattern(Short._str, Short._strLen), Long._str,
+        Long._strLen, K));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindLastNotOf(const TString& Other, sizeType Pos) const
+size_t TString::FindApprox(const TString& Needle, size_t K, sizeType Pos,
+    size_t* MatchLen) const
 {
-    return (_findLastOf(Other._str, Other._strLen, Pos, false));
+    const size_t Len = Needle._strLen;
+    sizeType End = npos;
+    size_t Best = npos;
+
+    if (Pos > _strLen)
+        return (npos);
+    if (Len == 0)
+    {
+        if (MatchLen)
+            *MatchLen = 0;
+        return (Pos);
+    }
+
+    // Leftmost end position within K errors, pushed right while the
+    // distance keeps decreasing. A needle of at most K characters already
+    // matches the empty string at Pos.
+    if (Len <= K)
+    {
+        End = Pos;
+        Best = Len;
+    }
+    _myersRun(_MyersPattern(Needle._str, Len), _str + Pos, _strLen - Pos,
+        false, 1, [&](size_t Column, size_t Score)
+    {
+        if (End != npos && Score >= Best)
+            return (false);
+        if (Score <= K)
+        {
+            End = Pos + Column;
+            Best = Score;
+        }
+        return (Score > 0 || End == npos);
+    });
+    if (End == npos)
+        return (npos);
+    if (End == Pos)
+    {
+        if (MatchLen)
+            *MatchLen = 0;
+        return (Pos);
+    }
+
+    // Start position: anchor the reversed needle at the end of the match
+    // and keep the longest extent reaching the best distance.
+    const size_t Window = std::min(End - Pos, Len + K);
+    size_t Start = End;
+    size_t Lowest = npos;
+    _myersRun(_MyersPattern(Needle._str, Len, true), _str + End - 1, Window,
+        true, -1, [&](size_t Column, size_t Score)
+    {
+        if (Score <= Lowest)
+        {
+            Lowest = Score;
+            Start = End - Column;
+        }
+        return (true);
+    });
+    if (MatchLen)
+        *MatchLen = End - Start;
+    return (Start);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindLastNotOf(const char* Other, sizeType Pos) const
+std::vector<size_t> TString::BatchEditDistance(const TString& Query,
+    const std::vector<TString>& Candidates, size_t K)
 {
-    return (_findLastOf(Other, ::strlen(Other), Pos, false));
+    std::vector<size_t> Distances;
+    const _MyersPattern Pattern(Query._str, Query._strLen);
+
+    if (K == npos)
+        K = npos - 1;
+    Distances.reserve(Candidates.size());
+    for (const TString& Candidate : Candidates)
+    {
+        Distances.push_back(_editDistance(Pattern, Candidate._str,
+            Candidate._strLen, K));
+    }
+    return (Distances);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindLastNotOf(const char* Other, sizeType Pos, size_t n) const
+void TString::Sort(std::vector<TString>& Strings, std::vector<size_t>* Lcp)
 {
-    return (_findLastOf(Other, n, Pos, false));
+    std::vector<_SortItem> Items(Strings.size());
+
+    for (size_t i = 0; i < Strings.size(); ++i)
+    {
+        Items[i].Str = &Strings[i];
+        _loadSortKey(Items[i], 0);
+    }
+    _multikeySort(Items.data(), Items.size(), 0);
+    _applySortOrder(Strings, Items, Lcp);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-size_t TString::FindLastNotOf(char Ch, sizeType Pos) const
+void TString::ParallelSort(std::vector<TString>& Strings, size_t Threads,
+    std::vector<size_t>* Lcp)
 {
-    return (_findLastOf(&Ch, 1, Pos, false));
+    // Bucket 0 holds the empty strings, then every first byte gets a bucket
+    // for the one-byte string followed by one per second byte.
+    static const size_t Buckets = 1 + 256 * 257;
+    static const size_t MinCount = 1 << 16;
+    const size_t Count = Strings.size();
+
+    if (Threads == 0)
+        Threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    if (Threads < 2 || Count < MinCount)
+        return (Sort(Strings, Lcp));
+
+    std::vector<_SortItem> Items(Count);
+    std::vector<size_t> Bucket(Count);
+    std::vector<size_t> Begin(Buckets + 1, 0);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        _SortItem& Item = Items[i];
+        Item.Str = &Strings[i];
+        _loadSortKey(Item, 0);
+        Bucket[i] = Item.Len == 0 ? 0 : 1 + (Item.Key >> 56) * 257 +
+            (Item.Len == 1 ? 0 : 1 + ((Item.Key >> 48) & 0xFF));
+        Begin[Bucket[i] + 1]++;
+    }
+    for (size_t b = 0; b < Buckets; ++b)
+        Begin[b + 1] += Begin[b];
+
+    std::vector<_SortItem> Sorted(Count);
+    std::vector<size_t> Next(Begin.begin(), Begin.end() - 1);
+    for (size_t i = 0; i < Count; ++i)
+        Sorted[Next[Bucket[i]]++] = Items[i];
+    _parallelFor(Buckets, Threads, [&](size_t b)
+    {
+        if (Begin[b + 1] - Begin[b] > 1)
+            _multikeySort(Sorted.data() + Begin[b], Begin[b + 1] - Begin[b], 0);
+    });
+    _applySortOrder(Strings, Sorted, Lcp);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -795,23 +4184,17 @@ TString TString::SubStr(sizeType Pos, size_t Len) const
     SafeDelete(Buffer);
     return (toReturn);
 }
-
-///////////////////////////////////////////////////////////////////////////////
-size_t TString::_find(const char* Other, size_t Len, sizeType Pos) const
-{
-    size_t toReturn = npos;
-
-    if (Pos == npos)
-        Pos = _strLen - 1;
-    for(; Pos <= _strLen; ++Pos)
-    {
-        if (operator[](Pos) == *Other && _findCompare(Other, Len, Pos))
-        {
-            toReturn = Pos;
-            break;
-        }
-    }
-    return (toReturn);
+
+///////////////////////////////////////////////////////////////////////////////
+size_t TString::_find(const char* Other, size_t Len, sizeType Pos) const
+{
+    if (Pos > _strLen || Len > _strLen - Pos)
+        return (npos);
+    if (Len == 0)
+        return (Pos);
+
+    const char* Found = _searchBytes(_str + Pos, _strLen - Pos, Other, Len);
+    return (Found ? static_cast<size_t>(Found - _str) : npos);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -897,6 +4280,29 @@ bool TString::_findOfCompare(const char* Other, size_t Len, sizeType Pos,
     return (!IsTrue);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+size_t TString::_findAll(const char* Other, size_t Len, sizeType Pos,
+    std::vector<sizeType>* Positions) const
+{
+    size_t Count = 0;
+
+    if (Len == 0)
+        return (0);
+    while (Pos <= _strLen && Len <= _strLen - Pos)
+    {
+        const char* Found = _searchBytes(_str + Pos, _strLen - Pos, Other,
+            Len);
+        if (!Found)
+            break;
+        Pos = Found - _str;
+        if (Positions)
+            Positions->push_back(Pos);
+        ++Count;
+        Pos += Len;
+    }
+    return (Count);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 size_t TString::Length(void) const
 {
@@ -977,41 +4383,173 @@ void TString::ShrinkToFit(void)
 ///////////////////////////////////////////////////////////////////////////////
 TString& TString::ToLowerCase(void)
 {
-    return (_transform(::towlower));
+    if (_asciiCase(_str, _str, _strLen, 'A'))
+        _localeCase(_str, _strLen, false);
+    return (*this);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 TString& TString::ToUpperCase(void)
 {
-    return (_transform(::toupper));
+    if (_asciiCase(_str, _str, _strLen, 'a'))
+        _localeCase(_str, _strLen, true);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString TString::ToLowerCopy(void) const
+{
+    TString Result(_strLen, ReserveTag());
+
+    if (_strLen == 0)
+        return (Result);
+    if (_asciiCase(_str, Result._str, _strLen, 'A'))
+        _localeCase(Result._str, _strLen, false);
+    Result._strLen = _strLen;
+    return (Result);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString TString::ToUpperCopy(void) const
+{
+    TString Result(_strLen, ReserveTag());
+
+    if (_strLen == 0)
+        return (Result);
+    if (_asciiCase(_str, Result._str, _strLen, 'a'))
+        _localeCase(Result._str, _strLen, true);
+    Result._strLen = _strLen;
+    return (Result);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 TString& TString::Trim(void)
 {
-    size_t start = 0;
-    size_t end = _strLen - 1;
+    const size_t End = _skipSpaceBack(_str, _strLen);
 
-    for (; start < _strLen && ::isspace(_str[start]); start++);
-    for (; end && ::isspace(_str[end]); end--);
+    return (_keepRange(_skipSpace(_str, End), End));
+}
 
-    if (start > 0 && end < _strLen - 1)
-    {
-        size_t newSize = end - start + 1;
-        char* newStr = new char[newSize + 1];
-        for (size_t i = 0; i < newSize; i++)
-        {
-            newStr[i] = _str[start + i];
-        }
-        newStr[newSize] = '\0';
-        delete[] _str;
-        _str = newStr;
-        _strLen = newSize;
-    }
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::TrimLeft(void)
+{
+    return (_keepRange(_skipSpace(_str, _strLen), _strLen));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::TrimRight(void)
+{
+    return (_keepRange(0, _skipSpaceBack(_str, _strLen)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::TrimChars(const TString& Set)
+{
+    sizeType Begin;
+    sizeType End;
+
+    _trimRange(Set, Begin, End);
+    return (_keepRange(Begin, End));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::SplitRange TString::Split(char Delim, bool SkipEmpty,
+    sizeType MaxSplits) const
+{
+    SplitRange Range(_str, _strLen, SplitRange::Kind::Char, SkipEmpty,
+        MaxSplits);
+
+    Range._char = Delim;
+    return (Range);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::SplitRange TString::Split(const TString& Sep, bool SkipEmpty,
+    sizeType MaxSplits) const
+{
+    SplitRange Range(_str, _strLen, SplitRange::Kind::Substring, SkipEmpty,
+        MaxSplits);
+
+    Range._sep.assign(Sep._str, Sep._str + Sep._strLen);
+    return (Range);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::SplitRange TString::SplitAny(const TString& Set, bool SkipEmpty,
+    sizeType MaxSplits) const
+{
+    SplitRange Range(_str, _strLen, SplitRange::Kind::Set, SkipEmpty,
+        MaxSplits);
+
+    Range._set = ByteSet(Set._str, Set._strLen);
+    return (Range);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string_view TString::TrimView(void) const
+{
+    const size_t End = _skipSpaceBack(_str, _strLen);
+    const size_t Begin = _skipSpace(_str, End);
+
+    return (Begin == End ? std::string_view() :
+        std::string_view(_str + Begin, End - Begin));
+}
 
+///////////////////////////////////////////////////////////////////////////////
+std::string_view TString::TrimLeftView(void) const
+{
+    const size_t Begin = _skipSpace(_str, _strLen);
+
+    return (Begin == _strLen ? std::string_view() :
+        std::string_view(_str + Begin, _strLen - Begin));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string_view TString::TrimRightView(void) const
+{
+    const size_t End = _skipSpaceBack(_str, _strLen);
+
+    return (End == 0 ? std::string_view() : std::string_view(_str, End));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string_view TString::TrimCharsView(const TString& Set) const
+{
+    sizeType Begin;
+    sizeType End;
+
+    _trimRange(Set, Begin, End);
+    return (Begin == End ? std::string_view() :
+        std::string_view(_str + Begin, End - Begin));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString& TString::_keepRange(sizeType Begin, sizeType End)
+{
+    if (Begin == 0 && End == _strLen)
+        return (*this);
+    if (Begin != 0)
+        ::memmove(_str, _str + Begin, End - Begin);
+    _clearStr(End - Begin);
     return (*this);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void TString::_trimRange(const TString& Set, sizeType& Begin, sizeType& End)
+    const
+{
+    bool InSet[256] = {false};
+
+    for (sizeType i = 0; i < Set._strLen; ++i)
+        InSet[static_cast<unsigned char>(Set._str[i])] = true;
+    Begin = 0;
+    End = _strLen;
+    while (End > 0 && InSet[static_cast<unsigned char>(_str[End - 1])])
+        End--;
+    while (Begin < End && InSet[static_cast<unsigned char>(_str[Begin])])
+        Begin++;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 bool TString::IsEmpty(void) const
 {
@@ -1042,13 +4580,10 @@ void TString::_setCapacity(const size_t Cap)
     _allocCString(_str, _strCap);
     if (Buffer)
     {
-        for (sizeType i = 0; i < _strLen; ++i)
-        {
-            operator[](i) = Buffer[i];
-        }
-        operator[](_strLen) = '\0';
+        ::memcpy(_str, Buffer, _strLen);
+        _str[_strLen] = '\0';
     }
-    SafeDelete(Buffer);
+    SafeDeleteArray(Buffer);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1625,12 +5160,337 @@ TString::ReverseIterator TString::ReverseIterator::operator-(sizeType i)
     return (toReturn);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+TString::ByteSet::ByteSet(void) {}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::ByteSet::ByteSet(const char* Chars, size_t Len)
+{
+    for (size_t i = 0; i < Len; ++i)
+    {
+        const unsigned char Ch = static_cast<unsigned char>(Chars[i]);
+        Has[Ch] = true;
+        Ascii = Ascii && Ch < 0x80;
+        Low[Ch & 15] |= 1 << ((Ch >> 4) & 7);
+    }
+    for (int Row = 0; Row < 8; ++Row)
+        High[Row] = 1 << Row;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::SplitRange::SplitRange(const char* Data, size_t Len, Kind Type,
+    bool SkipEmpty, sizeType MaxSplits) : _data(Data), _len(Len), _kind(Type),
+    _skipEmpty(SkipEmpty), _maxSplits(MaxSplits)
+{}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::SplitRange::Iterator TString::SplitRange::begin(void) const
+{
+    Iterator It;
+
+    It._range = this;
+    It._seek(0);
+    return (It);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::SplitRange::Iterator TString::SplitRange::end(void) const
+{
+    Iterator It;
+
+    It._range = this;
+    return (It);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<std::string_view> TString::SplitRange::ToVector(void) const
+{
+    std::vector<std::string_view> Tokens;
+
+    for (Iterator It = begin(); It != end(); ++It)
+        Tokens.push_back(*It);
+    return (Tokens);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::sizeType TString::SplitRange::_find(sizeType From) const
+{
+    const char* Hit = nullptr;
+
+    if (From >= _len)
+        return (npos);
+    if (_kind == Kind::Char)
+        Hit = static_cast<const char*>(::memchr(_data + From, _char,
+            _len - From));
+    else if (_kind == Kind::Set)
+    {
+        const size_t Run = _setRun(_data + From, _len - From, _set, false);
+        return (From + Run == _len ? npos : From + Run);
+    }
+    else if (!_sep.empty())
+        Hit = _searchBytes(_data + From, _len - From, _sep.data(),
+            _sep.size());
+    return (Hit ? static_cast<sizeType>(Hit - _data) : npos);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::sizeType TString::SplitRange::_skip(sizeType From) const
+{
+    sizeType Pos = From;
+
+    if (_kind == Kind::Char)
+    {
+        while (Pos < _len && _data[Pos] == _char)
+            Pos++;
+    }
+    else if (_kind == Kind::Set)
+        Pos += _setRun(_data + Pos, _len - Pos, _set, true);
+    else if (!_sep.empty())
+    {
+        while (_len - Pos >= _sep.size() &&
+            ::memcmp(_data + Pos, _sep.data(), _sep.size()) == 0)
+            Pos += _sep.size();
+    }
+    return (Pos - From);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::SplitRange::Iterator::Iterator(void) {}
+
+///////////////////////////////////////////////////////////////////////////////
+void TString::SplitRange::Iterator::_seek(sizeType From)
+{
+    const SplitRange& Range = *_range;
+
+    if (From != npos && Range._skipEmpty)
+    {
+        From += Range._skip(From);
+        if (From == Range._len)
+            From = npos;
+    }
+    _pos = From;
+    if (From == npos)
+        return;
+
+    const sizeType Hit = _splits < Range._maxSplits ? Range._find(From) : npos;
+    if (Hit == npos)
+    {
+        _end = Range._len;
+        _next = npos;
+        return;
+    }
+    _end = Hit;
+    _next = Hit + (Range._kind == Kind::Substring ? Range._sep.size() : 1);
+    _splits++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string_view TString::SplitRange::Iterator::operator*(void) const
+{
+    return (std::string_view(_range->_data + _pos, _end - _pos));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::SplitRange::Iterator& TString::SplitRange::Iterator::operator++(void)
+{
+    _seek(_next);
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::SplitRange::Iterator TString::SplitRange::Iterator::operator++(int)
+{
+    Iterator old = *this;
+    _seek(_next);
+    return (old);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TString::SplitRange::Iterator::operator==(const Iterator& Rhs) const
+{
+    return (_pos == Rhs._pos);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TString::SplitRange::Iterator::operator!=(const Iterator& Rhs) const
+{
+    return (!(*this == Rhs));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::CodePointIterator::CodePointIterator(void) {}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::CodePointIterator::CodePointIterator(const char* Data, size_t Len,
+    sizeType Pos) : _data(Data), _len(Len), _pos(Pos) {}
+
+///////////////////////////////////////////////////////////////////////////////
+char32_t TString::CodePointIterator::operator*(void) const
+{
+    sizeType Pos = _pos;
+
+    return (_decodeUtf8(_data, _len, Pos));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::CodePointIterator& TString::CodePointIterator::operator++(void)
+{
+    const unsigned char* Str = reinterpret_cast<const unsigned char*>(_data);
+    const size_t Size = _utf8Sequence(Str, _len, _pos);
+
+    _pos += Size ? Size : 1;
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::CodePointIterator TString::CodePointIterator::operator++(int)
+{
+    CodePointIterator old = *this;
+    ++(*this);
+    return (old);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TString::CodePointIterator::operator==(
+    const CodePointIterator& Rhs) const
+{
+    return (_pos == Rhs._pos);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TString::CodePointIterator::operator!=(
+    const CodePointIterator& Rhs) const
+{
+    return (!(*this == Rhs));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::sizeType TString::CodePointIterator::Offset(void) const
+{
+    return (_pos);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string_view TString::_view(const TString& Piece)
+{
+    return (std::string_view(Piece._str, Piece._strLen));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string_view TString::_view(std::string_view Piece)
+{
+    return (Piece);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string_view TString::_view(const char* Piece)
+{
+    return (Piece ? std::string_view(Piece) : std::string_view());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t TString::_joinThreads(size_t Size, size_t Count, size_t Threads)
+{
+    static const size_t MinParallel = 1 << 24;
+
+    if (Size < MinParallel || Count < 2)
+        return (1);
+    if (Threads == 0)
+        Threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    return (Threads);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TString::_join(std::string_view Separator,
+    const std::vector<std::string_view>& Pieces, size_t Threads, char* Dst)
+{
+    const size_t Count = Pieces.size();
+    std::vector<size_t> Offset(Count + 1, 0);
+
+    for (size_t i = 0; i < Count; ++i)
+        Offset[i + 1] = Offset[i] + (i ? Separator.size() : 0) +
+            Pieces[i].size();
+
+    // Blocks of pieces holding about the same number of bytes, a few per
+    // thread so that a large piece does not hold the others back.
+    const size_t Blocks = std::min(Count, Threads * 4);
+    std::vector<size_t> First(Blocks + 1, Count);
+    First[0] = 0;
+    for (size_t b = 1; b < Blocks; ++b)
+        First[b] = std::upper_bound(Offset.begin(), Offset.end(),
+            Offset[Count] / Blocks * b) - Offset.begin() - 1;
+    _parallelFor(Blocks, Threads, [&](size_t b)
+    {
+        for (size_t i = First[b]; i < First[b + 1]; ++i)
+        {
+            char* At = Dst + Offset[i];
+            if (i && !Separator.empty())
+            {
+                ::memcpy(At, Separator.data(), Separator.size());
+                At += Separator.size();
+            }
+            if (!Pieces[i].empty())
+                ::memcpy(At, Pieces[i].data(), Pieces[i].size());
+        }
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+char* TString::_reserveTail(size_t Len)
+{
+    if (_strCap < _strLen + Len || !_str)
+        _setCapacity(std::max(_strLen + Len, 2 * _strCap));
+    return (_str + _strLen);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TString::_commitTail(size_t Len)
+{
+    _strLen += Len;
+    _str[_strLen] = '\0';
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void Swap(TString& A, TString& B)
 {
     A.Swap(B);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+uint64_t TString::Hash(uint64_t Seed) const
+{
+    return (HashBytes(_str, _strLen, Seed));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+uint64_t TString::HashBytes(const void* Data, size_t Len, uint64_t Seed)
+{
+    return (_wyHash(static_cast<const unsigned char*>(Data), Len, Seed));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::SeededHasher::SeededHasher(void)
+{
+    static const uint64_t ProcessSeed = [](void)
+    {
+        std::random_device Device;
+        return ((uint64_t(Device()) << 32) ^ Device());
+    }();
+
+    Seed = ProcessSeed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString::SeededHasher::SeededHasher(uint64_t Seed)
+    : Seed(Seed)
+{}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t TString::SeededHasher::operator()(const TString& Str) const
+{
+    return (static_cast<size_t>(Str.Hash(Seed)));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 TString operator+(const TString& Lhs, const TString& Rhs)
 {
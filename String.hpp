@@ -29,6 +29,13 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+///////////////////////////////////////////////////////////////////////////////
+// Language version: std::string_view and std::to_chars need C++17
+///////////////////////////////////////////////////////////////////////////////
+#if __cplusplus < 201703L && (!defined(_MSVC_LANG) || _MSVC_LANG < 201703L)
+    #error "String.hpp requires C++17 or later"
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // Headers
 ///////////////////////////////////////////////////////////////////////////////
@@ -36,6 +43,12 @@
 #include <utility>
 #include <cstdlib>
 #include <cstring>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 /// \brief Safely deletes a dynamically allocated object and sets the pointer
@@ -840,6 +853,327 @@ public:
     using ConstReversePointer = ConstReverseIterator;
     using ReversePointer = ReverseIterator;
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief CodePointIterator class for reading a String object as UTF-8.
+    ///
+    /// Each step decodes one code point. An invalid sequence reads as
+    /// U+FFFD and only its first byte is skipped, so iteration always ends.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    class CodePointIterator
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Default constructor for CodePointIterator.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        CodePointIterator(void);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Constructs a CodePointIterator over a byte range.
+        ///
+        /// \param Data First byte of the string.
+        /// \param Len Number of bytes.
+        /// \param Pos Byte offset of the current code point.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        CodePointIterator(const char* Data, size_t Len, sizeType Pos);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Decodes the code point at the current position.
+        ///
+        /// \return The code point.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        char32_t operator*(void) const;
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Moves to the next code point.
+        ///
+        /// \return A reference to the incremented iterator.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        CodePointIterator& operator++(void);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Moves to the next code point.
+        ///
+        /// \return A copy of the iterator before the increment.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        CodePointIterator operator++(int);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Equality operator to compare two iterators.
+        ///
+        /// \param Rhs The iterator to compare with.
+        ///
+        /// \return True if both iterators are at the same byte offset.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        bool operator==(const CodePointIterator& Rhs) const;
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Inequality operator to compare two iterators.
+        ///
+        /// \param Rhs The iterator to compare with.
+        ///
+        /// \return True if the iterators are at different byte offsets.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        bool operator!=(const CodePointIterator& Rhs) const;
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Byte offset of the current code point in the string.
+        ///
+        /// \return The offset.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        sizeType Offset(void) const;
+
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Private member data.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        const char* _data = nullptr;    //<! First byte of the string.
+        size_t _len = 0;                //<! Number of bytes.
+        sizeType _pos = 0;              //<! Offset of the current code point.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Digit sets for Base64, see `ToBase64`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    enum class Base64Alphabet
+    {
+        Standard,   //<! RFC 4648 section 4, digits `+` and `/`.
+        Url         //<! RFC 4648 section 5, digits `-` and `_`.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Sets of bytes left as they are by `UrlEncode`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    enum class UrlMode
+    {
+        Component,  //<! Unreserved characters of RFC 3986 only.
+        Path,       //<! Also sub-delimiters, `:`, `@` and `/`.
+        Form        //<! `*-._` and alphanumerics, space as `+`.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A set of bytes, with the tables of a vectorized lookup.
+    ///
+    /// `Low` and `High` split an ASCII set for a two-shuffle lookup: a byte
+    /// is in the set when `Low[Byte & 15] & High[Byte >> 4]` is not zero,
+    /// where `High` holds one bit per ASCII row and nothing for bytes with
+    /// the top bit set. Sets holding such bytes use `Has` alone.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    struct ByteSet
+    {
+        bool Has[256] = {};         //<! True for the bytes in the set.
+        unsigned char Low[16] = {}; //<! Rows holding each low nibble.
+        unsigned char High[16] = {};//<! Bit of each row.
+        bool Ascii = true;          //<! True if the lookup tables apply.
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Constructs an empty set.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        ByteSet(void);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Constructs the set of the bytes of a buffer.
+        ///
+        /// \param Chars The bytes.
+        /// \param Len Number of bytes.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        ByteSet(const char* Chars, size_t Len);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Lazy range of the tokens of a string, see `Split`.
+    ///
+    /// Tokens are views into the split string, which must outlive the range
+    /// and stay unmodified while it is in use. `begin` and `end` are lower
+    /// case so that the range works with range-based for loops.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    class SplitRange
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Forward iterator over the tokens.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        class Iterator
+        {
+        public:
+            ///////////////////////////////////////////////////////////////////
+            /// \brief Constructs an end iterator.
+            ///
+            ///////////////////////////////////////////////////////////////////
+            Iterator(void);
+
+            ///////////////////////////////////////////////////////////////////
+            /// \brief Retrieves the current token.
+            ///
+            /// \return A view of the token.
+            ///
+            ///////////////////////////////////////////////////////////////////
+            std::string_view operator*(void) const;
+
+            ///////////////////////////////////////////////////////////////////
+            /// \brief Moves to the next token.
+            ///
+            /// \return A reference to the incremented iterator.
+            ///
+            ///////////////////////////////////////////////////////////////////
+            Iterator& operator++(void);
+
+            ///////////////////////////////////////////////////////////////////
+            /// \brief Moves to the next token.
+            ///
+            /// \return A copy of the iterator before the increment.
+            ///
+            ///////////////////////////////////////////////////////////////////
+            Iterator operator++(int);
+
+            ///////////////////////////////////////////////////////////////////
+            /// \brief Equality operator to compare two iterators.
+            ///
+            /// \param Rhs The iterator to compare with.
+            ///
+            /// \return True if both iterators are at the same token.
+            ///
+            ///////////////////////////////////////////////////////////////////
+            bool operator==(const Iterator& Rhs) const;
+
+            ///////////////////////////////////////////////////////////////////
+            /// \brief Inequality operator to compare two iterators.
+            ///
+            /// \param Rhs The iterator to compare with.
+            ///
+            /// \return True if the iterators are at different tokens.
+            ///
+            ///////////////////////////////////////////////////////////////////
+            bool operator!=(const Iterator& Rhs) const;
+
+        private:
+            ///////////////////////////////////////////////////////////////////
+            /// \brief Finds the token starting at a position.
+            ///
+            /// \param From Start of the token, or `npos` past the last one.
+            ///
+            ///////////////////////////////////////////////////////////////////
+            void _seek(sizeType From);
+
+            ///////////////////////////////////////////////////////////////////
+            /// \brief Grants the range access to the constructor state.
+            ///
+            ///////////////////////////////////////////////////////////////////
+            friend class SplitRange;
+
+        private:
+            ///////////////////////////////////////////////////////////////////
+            /// \brief Private member data.
+            ///
+            ///////////////////////////////////////////////////////////////////
+            const SplitRange* _range = nullptr; //<! Range iterated over.
+            sizeType _pos = npos;       //<! Start of the token, or `npos`.
+            sizeType _end = 0;          //<! End of the token.
+            sizeType _next = npos;      //<! Start of the next token.
+            sizeType _splits = 0;       //<! Delimiters consumed so far.
+        };
+
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Returns an iterator to the first token.
+        ///
+        /// \return The iterator.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        Iterator begin(void) const;
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Returns an iterator past the last token.
+        ///
+        /// \return The iterator.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        Iterator end(void) const;
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Collects every token.
+        ///
+        /// \return The views, in order.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        std::vector<std::string_view> ToVector(void) const;
+
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Kinds of delimiter.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        enum class Kind
+        {
+            Char,       //<! A single byte.
+            Set,        //<! Any byte of a set.
+            Substring   //<! A sequence of bytes.
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Constructs a range, see `Split`.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        SplitRange(const char* Data, size_t Len, Kind Type, bool SkipEmpty,
+            sizeType MaxSplits);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Finds the next delimiter.
+        ///
+        /// \param From Position to search from.
+        ///
+        /// \return The position of the delimiter, or `npos`.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        sizeType _find(sizeType From) const;
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Measures the delimiters found back to back at a position.
+        ///
+        /// \param From Position to look at.
+        ///
+        /// \return The number of bytes they span.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        sizeType _skip(sizeType From) const;
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Grants the string access to the constructor.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        friend class TString;
+
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Private member data.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        const char* _data;          //<! First byte of the string.
+        size_t _len;                //<! Number of bytes.
+        Kind _kind;                 //<! Kind of delimiter.
+        bool _skipEmpty;            //<! True to drop empty tokens.
+        sizeType _maxSplits;        //<! Most delimiters to split on.
+        char _char = 0;             //<! Delimiter, for `Kind::Char`.
+        ByteSet _set;               //<! Delimiters, for `Kind::Set`.
+        std::vector<char> _sep;     //<! Delimiter, for `Kind::Substring`.
+    };
+
 public:
     ///////////////////////////////////////////////////////////////////////////
     /// \brief
@@ -908,6 +1242,22 @@ public:
     ///////////////////////////////////////////////////////////////////////////
     TString(const ConstIterator First, const ConstIterator Second);
 
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Selects the reserving constructor.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    struct ReserveTag {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Builds an empty string whose buffer holds `Cap` bytes, in a
+    /// single allocation, for results that are written in place.
+    ///
+    /// \param Cap The capacity.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString(size_t Cap, ReserveTag);
+
 public:
     ///////////////////////////////////////////////////////////////////////////
     /// \brief
@@ -1138,11 +1488,15 @@ public:
 
 private:
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Compares two strings lexicographically.
     ///
-    /// \param rhs
+    /// Bytes are compared as unsigned values, embedded NULs included; the
+    /// shorter string comes first when one is a prefix of the other.
     ///
-    /// \return
+    /// \param rhs The string to compare with.
+    ///
+    /// \return A negative value, zero or a positive value if this string is
+    /// respectively lower than, equal to or greater than `rhs`.
     ///
     ///////////////////////////////////////////////////////////////////////////
     int _compare(const TString& rhs) const;
@@ -1580,6 +1934,43 @@ public:
     TString& Replace(ConstIterator It1, ConstIterator It2, ConstIterator First,
         ConstIterator Second);
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces every non-overlapping occurrence of a string.
+    ///
+    /// Occurrences are located in a single scan. The result is built in place
+    /// when `To` is not longer than `From`, otherwise in one exact-size
+    /// allocation.
+    ///
+    /// \param From The string to search for, nothing is done when empty.
+    /// \param To The replacement.
+    ///
+    /// \return A reference to this string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& ReplaceAll(const TString& From, const TString& To);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces every non-overlapping occurrence of a C-string.
+    ///
+    /// \param From The string to search for, nothing is done when empty.
+    /// \param To The replacement.
+    ///
+    /// \return A reference to this string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& ReplaceAll(const char* From, const char* To);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces every occurrence of a character, in place.
+    ///
+    /// \param From The character to search for.
+    /// \param To The replacement character.
+    ///
+    /// \return A reference to this string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& ReplaceAll(char From, char To);
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief
     ///
@@ -1665,6 +2056,18 @@ private:
     ///////////////////////////////////////////////////////////////////////////
     void _replace(sizeType Pos, size_t Len, const char* Other, size_t n);
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces every non-overlapping occurrence of a string.
+    ///
+    /// \param From The string to search for.
+    /// \param FromLen Length of `From`.
+    /// \param To The replacement.
+    /// \param ToLen Length of `To`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void _replaceAll(const char* From, size_t FromLen, const char* To,
+        size_t ToLen);
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief
     ///
@@ -1970,141 +2373,971 @@ public:
     sizeType FindLastNotOf(char Ch, sizeType Pos = npos) const;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Finds every non-overlapping occurrence of a string.
     ///
-    /// \param Pos
-    /// \param Len
+    /// The string is scanned once, an empty needle yields no occurrence.
     ///
-    /// \return
+    /// \param Other The string to search for.
+    /// \param Pos Position of the first character to be considered.
+    ///
+    /// \return The positions of the occurrences, in increasing order.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    TString SubStr(sizeType Pos = 0, size_t Len = npos) const;
+    std::vector<sizeType> FindAll(const TString& Other, sizeType Pos = 0) const;
 
-private:
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Finds every non-overlapping occurrence of a C-string.
     ///
-    /// \param Other
-    /// \param Len
-    /// \param Pos
+    /// \param Other The string to search for.
+    /// \param Pos Position of the first character to be considered.
     ///
-    /// \return
+    /// \return The positions of the occurrences, in increasing order.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    sizeType _find(const char* Other, size_t Len, sizeType Pos) const;
+    std::vector<sizeType> FindAll(const char* Other, sizeType Pos = 0) const;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Finds every occurrence of a character.
     ///
-    /// \param Other
-    /// \param Len
-    /// \param Pos
+    /// \param Ch The character to search for.
+    /// \param Pos Position of the first character to be considered.
     ///
-    /// \return
+    /// \return The positions of the occurrences, in increasing order.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    sizeType _rfind(const char* Other, size_t Len, sizeType Pos) const;
+    std::vector<sizeType> FindAll(char Ch, sizeType Pos = 0) const;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Counts the non-overlapping occurrences of a string.
     ///
-    /// \param Other
-    /// \param Len
-    /// \param Pos
+    /// \param Other The string to search for.
+    /// \param Pos Position of the first character to be considered.
     ///
-    /// \return
+    /// \return The number of occurrences, 0 for an empty needle.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    bool _findCompare(const char* Other, size_t Len, sizeType Pos) const;
+    size_t Count(const TString& Other, sizeType Pos = 0) const;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Counts the non-overlapping occurrences of a C-string.
     ///
-    /// \param Other
-    /// \param Len
-    /// \param Pos
-    /// \param IsTrue
+    /// \param Other The string to search for.
+    /// \param Pos Position of the first character to be considered.
     ///
-    /// \return
+    /// \return The number of occurrences, 0 for an empty needle.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    sizeType _findFirstOf(const char* Other, size_t Len, sizeType Pos,
-        bool IsTrue) const;
+    size_t Count(const char* Other, sizeType Pos = 0) const;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Counts the occurrences of a character.
     ///
-    /// \param Other
-    /// \param Len
-    /// \param Pos
-    /// \param IsTrue
+    /// \param Ch The character to search for.
+    /// \param Pos Position of the first character to be considered.
     ///
-    /// \return
+    /// \return The number of occurrences.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    sizeType _findLastOf(const char* Other, size_t Len, sizeType Pos,
-        bool IsTrue) const;
+    size_t Count(char Ch, sizeType Pos = 0) const;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Finds the first occurrence of a string using several threads.
     ///
-    /// \param Other
-    /// \param Len
-    /// \param Pos
-    /// \param IsTrue
+    /// The string is split in chunks overlapping by the needle length, which
+    /// worker threads pick in order. Chunks starting after an occurrence
+    /// already found are skipped. Small strings are searched sequentially.
     ///
-    /// \return
+    /// \param Other The string to search for.
+    /// \param Threads Number of threads, 0 for the hardware concurrency.
+    ///
+    /// \return The position of the first occurrence, or `npos`.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    bool _findOfCompare(const char* Other, size_t Len, sizeType Pos,
-        bool IsTrue) const;
+    sizeType ParallelFind(const TString& Other, size_t Threads = 0) const;
 
-public:
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Finds every non-overlapping occurrence of a string using
+    /// several threads.
     ///
-    /// \return
+    /// Every chunk is scanned greedily from its start. The chunks are then
+    /// merged in order, and a chunk entered past its start, because the
+    /// last occurrence of the previous one runs into it, is scanned again
+    /// from there until the two scans meet. Only the occurrences themselves
+    /// are stored.
+    ///
+    /// \param Other The string to search for.
+    /// \param Threads Number of threads, 0 for the hardware concurrency.
+    ///
+    /// \return The same positions as `FindAll`.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    size_t Length(void) const;
+    std::vector<sizeType> ParallelFindAll(const TString& Other,
+        size_t Threads = 0) const;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Counts the non-overlapping occurrences of a string using
+    /// several threads.
     ///
-    /// \return
+    /// Chunks are counted as in `ParallelFindAll`, keeping only a count and
+    /// the last occurrence of each, so no positions are stored.
+    ///
+    /// \param Other The string to search for.
+    /// \param Threads Number of threads, 0 for the hardware concurrency.
+    ///
+    /// \return The same count as `Count`.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    inline size_t Size(void) const;
+    size_t ParallelCount(const TString& Other, size_t Threads = 0) const;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Finds the first occurrence of a string, ignoring ASCII case.
     ///
-    /// \return
+    /// Only `A`-`Z` and `a`-`z` are folded, every other byte has to match
+    /// exactly. The haystack is folded on the fly, nothing is allocated.
+    ///
+    /// \param Other The string to search for.
+    /// \param Pos Position of the first character to be considered.
+    ///
+    /// \return The position of the first occurrence, or `npos`.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    size_t MaxSize(void) const;
+    sizeType FindIgnoreCase(const TString& Other, sizeType Pos = 0) const;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Finds the first occurrence of a C-string, ignoring ASCII case.
     ///
-    /// \param n
+    /// \param Other The string to search for.
+    /// \param Pos Position of the first character to be considered.
+    ///
+    /// \return The position of the first occurrence, or `npos`.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    void Resize(size_t n);
+    sizeType FindIgnoreCase(const char* Other, sizeType Pos = 0) const;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Tells whether two strings are equal, ignoring ASCII case.
     ///
-    /// \param n
-    /// \param Filler
+    /// \param Other The string to compare with.
+    ///
+    /// \return True if both strings are equal once folded.
     ///
     ///////////////////////////////////////////////////////////////////////////
-    void Resize(sizeType n, char Filler);
+    bool EqualsIgnoreCase(const TString& Other) const;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Tells whether this string equals a C-string, ignoring ASCII
+    /// case.
     ///
-    /// \return
+    /// \param Other The string to compare with.
+    ///
+    /// \return True if both strings are equal once folded.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool EqualsIgnoreCase(const char* Other) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Compares two strings lexicographically, ignoring ASCII case.
+    ///
+    /// Bytes are compared as unsigned values once folded to lower case, the
+    /// shorter string comes first when one is a prefix of the other.
+    ///
+    /// \param Other The string to compare with.
+    ///
+    /// \return A negative value, zero or a positive value if this string is
+    /// respectively lower than, equal to or greater than `Other`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    int CompareIgnoreCase(const TString& Other) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Tells whether this string starts with a prefix, ignoring ASCII
+    /// case.
+    ///
+    /// \param Prefix The prefix.
+    ///
+    /// \return True if the string starts with `Prefix`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool StartsWithIgnoreCase(const TString& Prefix) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Tells whether this string starts with a C-string prefix,
+    /// ignoring ASCII case.
+    ///
+    /// \param Prefix The prefix.
+    ///
+    /// \return True if the string starts with `Prefix`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool StartsWithIgnoreCase(const char* Prefix) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Tells whether the string only holds 7-bit ASCII characters.
+    ///
+    /// \return True if no byte has its high bit set.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool IsAscii(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Tells whether the string is well-formed UTF-8.
+    ///
+    /// Overlong forms, surrogates, code points above U+10FFFF and truncated
+    /// sequences are rejected. Uses the Keiser-Lemire lookup validator with
+    /// AVX2 or SSSE3 when available, and skips ASCII 64 bytes at a time.
+    ///
+    /// \param ErrorOffset If not null, receives the offset of the first byte
+    /// of the first invalid sequence, or `npos` if the string is valid.
+    ///
+    /// \return True if the string is valid UTF-8.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool IsValidUtf8(sizeType* ErrorOffset = nullptr) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Tells whether a buffer is well-formed UTF-8, as `IsValidUtf8`.
+    ///
+    /// \param Data The bytes, may be null when `Len` is 0.
+    /// \param Len Number of bytes.
+    /// \param ErrorOffset If not null, receives the offset of the first byte
+    /// of the first invalid sequence, or `npos` if the buffer is valid.
+    ///
+    /// \return True if the buffer is valid UTF-8.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static bool ValidateUtf8(const char* Data, size_t Len,
+        sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Appends a buffer only if it is well-formed UTF-8.
+    ///
+    /// \param Data The bytes to append.
+    /// \param Len Number of bytes.
+    /// \param ErrorOffset If not null, receives the offset of the first
+    /// invalid sequence in `Data`, or `npos`.
+    ///
+    /// \return True if the buffer was valid and appended; the string is left
+    /// unchanged otherwise.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool AppendUtf8(const char* Data, size_t Len,
+        sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Builds a string from a buffer only if it is well-formed UTF-8.
+    ///
+    /// \param Data The bytes.
+    /// \param Len Number of bytes.
+    /// \param Out Receives the string; left unchanged on failure.
+    /// \param ErrorOffset If not null, receives the offset of the first
+    /// invalid sequence in `Data`, or `npos`.
+    ///
+    /// \return True if the buffer was valid.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static bool FromUtf8(const char* Data, size_t Len, TString& Out,
+        sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Counts the code points of the string, read as UTF-8.
+    ///
+    /// Counts the bytes that are not continuation bytes, with AVX2 or SSE2
+    /// when available; this is exact for valid UTF-8.
+    ///
+    /// \return The number of code points.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType CodePointCount(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Converts a byte offset to a code point index.
+    ///
+    /// \param Offset A byte offset, at most `Length()`.
+    ///
+    /// \return The number of code points starting before `Offset`, or `npos`
+    /// if `Offset` is past the end.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType CodePointIndex(sizeType Offset) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Converts a code point index to a byte offset.
+    ///
+    /// \param Index A code point index, at most `CodePointCount()`.
+    ///
+    /// \return The offset of the first byte of the code point, `Length()`
+    /// if `Index` is `CodePointCount()`, or `npos` if it is larger.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType ByteOffset(sizeType Index) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Returns an iterator to the first code point.
+    ///
+    /// \return The iterator.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    CodePointIterator CodePointBegin(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Returns an iterator past the last code point.
+    ///
+    /// \return The iterator.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    CodePointIterator CodePointEnd(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Transcodes the string from UTF-8 to UTF-16.
+    ///
+    /// Units are in host byte order and code points above U+FFFF become
+    /// surrogate pairs. Runs of ASCII are widened 16 bytes at a time.
+    ///
+    /// \param Out Receives the units; left unchanged on failure.
+    ///
+    /// \return False if the string is not valid UTF-8.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool ToUtf16(std::u16string& Out) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Transcodes the string from UTF-8 to UTF-32.
+    ///
+    /// \param Out Receives the code points; left unchanged on failure.
+    ///
+    /// \return False if the string is not valid UTF-8.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool ToUtf32(std::u32string& Out) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Builds a UTF-8 string from UTF-16 in host byte order.
+    ///
+    /// \param Data The units.
+    /// \param Len Number of units.
+    /// \param Out Receives the string; left unchanged on failure.
+    /// \param ErrorOffset If not null, receives the index of the first
+    /// unpaired surrogate, or `npos`.
+    ///
+    /// \return False if the input holds an unpaired surrogate.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static bool FromUtf16(const char16_t* Data, size_t Len, TString& Out,
+        sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Builds a UTF-8 string from UTF-32.
+    ///
+    /// \param Data The code points.
+    /// \param Len Number of code points.
+    /// \param Out Receives the string; left unchanged on failure.
+    /// \param ErrorOffset If not null, receives the index of the first
+    /// surrogate or value above U+10FFFF, or `npos`.
+    ///
+    /// \return False if the input holds an invalid code point.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static bool FromUtf32(const char32_t* Data, size_t Len, TString& Out,
+        sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Encodes the string as Base64.
+    ///
+    /// The result is written into a single allocation of the exact size,
+    /// 24 input bytes per step with AVX2 when available.
+    ///
+    /// \param Alphabet The digit set.
+    /// \param Padding True to pad the last group with `=`.
+    ///
+    /// \return The encoded string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString ToBase64(Base64Alphabet Alphabet = Base64Alphabet::Standard,
+        bool Padding = true) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes Base64 into a new string.
+    ///
+    /// Padding is optional but must be correct when present, and the unused
+    /// bits of the last digit must be zero.
+    ///
+    /// \param Data The digits.
+    /// \param Len Number of digits.
+    /// \param Out Receives the bytes; left unchanged on failure.
+    /// \param Alphabet The digit set.
+    /// \param ErrorOffset If not null, receives the offset of the first
+    /// invalid digit, or `npos`.
+    ///
+    /// \return True if the input was valid.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static bool FromBase64(const char* Data, size_t Len, TString& Out,
+        Base64Alphabet Alphabet = Base64Alphabet::Standard,
+        sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Appends the Base64 encoding of a buffer.
+    ///
+    /// Grows the string at most once, at least doubling its capacity.
+    /// Appending lengths that are multiples of 3 encodes a stream piece by
+    /// piece, in linear time overall.
+    ///
+    /// \param Data The bytes, which must not point into this string.
+    /// \param Len Number of bytes.
+    /// \param Alphabet The digit set.
+    /// \param Padding True to pad the last group with `=`.
+    ///
+    /// \return A reference to the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& AppendBase64(const char* Data, size_t Len,
+        Base64Alphabet Alphabet = Base64Alphabet::Standard,
+        bool Padding = true);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes Base64 and appends the bytes, as `FromBase64`.
+    ///
+    /// \param Data The digits, which must not point into this string.
+    /// \param Len Number of digits.
+    /// \param Alphabet The digit set.
+    /// \param ErrorOffset If not null, receives the offset of the first
+    /// invalid digit, or `npos`.
+    ///
+    /// \return True if the input was valid; the string is left unchanged
+    /// otherwise.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool AppendFromBase64(const char* Data, size_t Len,
+        Base64Alphabet Alphabet = Base64Alphabet::Standard,
+        sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Encodes the string as hexadecimal, two digits per byte.
+    ///
+    /// The result is written into a single allocation of the exact size,
+    /// 16 bytes per step with SSE2 when available.
+    ///
+    /// \param Upper True for digits `A`-`F`, false for `a`-`f`.
+    ///
+    /// \return The encoded string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString ToHex(bool Upper = false) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes hexadecimal into a new string.
+    ///
+    /// Both letter cases are accepted; anything else, including an odd
+    /// number of digits, is an error.
+    ///
+    /// \param Data The digits.
+    /// \param Len Number of digits.
+    /// \param Out Receives the bytes; left unchanged on failure.
+    /// \param ErrorOffset If not null, receives the offset of the first
+    /// invalid digit, or of the unpaired last one, or `npos`.
+    ///
+    /// \return True if the input was valid.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static bool FromHex(const char* Data, size_t Len, TString& Out,
+        sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Appends the hexadecimal encoding of a buffer.
+    ///
+    /// Grows the string at most once, at least doubling its capacity so
+    /// that repeated appends stay linear, and writes the digits in place.
+    ///
+    /// \param Data The bytes, which must not point into this string.
+    /// \param Len Number of bytes.
+    /// \param Upper True for digits `A`-`F`, false for `a`-`f`.
+    ///
+    /// \return A reference to the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& AppendHex(const char* Data, size_t Len, bool Upper = false);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes hexadecimal and appends the bytes, as `FromHex`.
+    ///
+    /// \param Data The digits, which must not point into this string.
+    /// \param Len Number of digits.
+    /// \param ErrorOffset If not null, receives the offset of the first
+    /// invalid digit, or of the unpaired last one, or `npos`.
+    ///
+    /// \return True if the input was valid; the string is left unchanged
+    /// otherwise.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool AppendFromHex(const char* Data, size_t Len,
+        sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Percent-encodes the string.
+    ///
+    /// Runs of safe bytes are found with a two-shuffle class lookup, 32 or 16
+    /// bytes per step with AVX2 or SSSE3, and copied in bulk. Escapes use
+    /// upper case digits. The output is sized first and written into a
+    /// single allocation.
+    ///
+    /// \param Mode The set of bytes left as they are.
+    ///
+    /// \return The encoded string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString UrlEncode(UrlMode Mode = UrlMode::Component) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Percent-decodes a buffer into a new string.
+    ///
+    /// Every `%` must start an escape of two hexadecimal digits. In `Form`
+    /// mode a `+` decodes to a space; any other byte is copied as is.
+    ///
+    /// \param Data The encoded bytes.
+    /// \param Len Number of bytes.
+    /// \param Out Receives the bytes; left unchanged on failure.
+    /// \param Mode `Form` to decode `+` as a space.
+    /// \param ErrorOffset If not null, receives the offset of the first bad
+    /// `%`, or `npos`.
+    ///
+    /// \return True if the input was valid.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static bool UrlDecode(const char* Data, size_t Len, TString& Out,
+        UrlMode Mode = UrlMode::Component, sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Appends the percent-encoding of a buffer, as `UrlEncode`.
+    ///
+    /// Grows the string at most once, at least doubling its capacity, so
+    /// encoding many values into one buffer takes linear time.
+    ///
+    /// \param Data The bytes, which must not point into this string.
+    /// \param Len Number of bytes.
+    /// \param Mode The set of bytes left as they are.
+    ///
+    /// \return A reference to the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& AppendUrlEncode(const char* Data, size_t Len,
+        UrlMode Mode = UrlMode::Component);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Percent-decodes a buffer and appends the bytes, as
+    /// `UrlDecode`.
+    ///
+    /// \param Data The encoded bytes, which must not point into this string.
+    /// \param Len Number of bytes.
+    /// \param Mode `Form` to decode `+` as a space.
+    /// \param ErrorOffset If not null, receives the offset of the first bad
+    /// `%`, or `npos`.
+    ///
+    /// \return True if the input was valid; the string is left unchanged
+    /// otherwise.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool AppendUrlDecode(const char* Data, size_t Len,
+        UrlMode Mode = UrlMode::Component, sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Appends the string to another, escaped for use inside a JSON
+    /// string literal.
+    ///
+    /// `"`, `\\` and control characters are escaped, with the short forms
+    /// where JSON has one and `\\u00XX` otherwise; every other byte,
+    /// including UTF-8, is copied as is. Clean spans are found 32 or 16 bytes
+    /// at a time with AVX2 or SSE2 and copied in bulk straight into `Dest`,
+    /// which grows at most once and then at least doubles, so building a
+    /// document field by field stays linear. No quotes are added.
+    ///
+    /// \param Dest The string to append to, which may be this one.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void JsonEscapeAppend(TString& Dest) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Unescapes the content of a JSON string literal into a new
+    /// string.
+    ///
+    /// `\\uXXXX` escapes are written as UTF-8, and surrogates must come in
+    /// valid pairs. Unescaped `"` and control characters are errors, as in
+    /// JSON.
+    ///
+    /// \param Data The content, without the surrounding quotes.
+    /// \param Len Number of bytes.
+    /// \param Out Receives the string; left unchanged on failure.
+    /// \param ErrorOffset If not null, receives the offset of the first
+    /// invalid byte or escape, or `npos`.
+    ///
+    /// \return True if the input was valid.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static bool JsonUnescape(const char* Data, size_t Len, TString& Out,
+        sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Unescapes JSON string content and appends it, as
+    /// `JsonUnescape`.
+    ///
+    /// \param Data The content, which must not point into this string.
+    /// \param Len Number of bytes.
+    /// \param ErrorOffset If not null, receives the offset of the first
+    /// invalid byte or escape, or `npos`.
+    ///
+    /// \return True if the input was valid; the string is left unchanged
+    /// otherwise.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool AppendJsonUnescape(const char* Data, size_t Len,
+        sizeType* ErrorOffset = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Appends a signed integer in decimal.
+    ///
+    /// Digits are written two at a time from a pair table, straight into
+    /// the spare capacity of the string.
+    ///
+    /// \param Value The number.
+    ///
+    /// \return A reference to the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& AppendInt(int64_t Value);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Appends an unsigned integer in decimal, as `AppendInt`.
+    ///
+    /// \param Value The number.
+    ///
+    /// \return A reference to the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& AppendUInt(uint64_t Value);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Appends a double in its shortest round-trip form.
+    ///
+    /// Formatted with `std::to_chars`, straight into the spare capacity of
+    /// the string; parsing the text back gives the same value. Infinities
+    /// and NaNs are written `inf`, `-inf` and `nan`.
+    ///
+    /// \param Value The number.
+    ///
+    /// \return A reference to the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& AppendDouble(double Value);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Appends a float in its shortest round-trip form, as
+    /// `AppendDouble`.
+    ///
+    /// \param Value The number.
+    ///
+    /// \return A reference to the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& AppendFloat(float Value);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Formats a number, with `AppendInt`, `AppendUInt`,
+    /// `AppendFloat` or `AppendDouble` according to its type.
+    ///
+    /// A `char` gives the one-character string and a `bool` gives "true" or
+    /// "false"; `signed char` and `unsigned char` are formatted as numbers.
+    /// Wide character types are rejected.
+    ///
+    /// \param Value The number; a `long double` is formatted as a double.
+    ///
+    /// \return The formatted number.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    static TString From(T Value);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Computes the Levenshtein distance to another string.
+    ///
+    /// Uses Myers' bit-parallel algorithm, in 64-row blocks for strings
+    /// longer than 64 characters.
+    ///
+    /// \param Other The string to compare with.
+    ///
+    /// \return The minimum number of insertions, deletions and substitutions
+    /// turning this string into `Other`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    size_t EditDistance(const TString& Other) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Computes the Levenshtein distance to another string, giving up
+    /// as soon as it is known to exceed a bound.
+    ///
+    /// \param Other The string to compare with.
+    /// \param K The largest distance of interest.
+    ///
+    /// \return The distance, or `npos` if it is greater than `K`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    size_t BoundedEditDistance(const TString& Other, size_t K) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the first approximate occurrence of a string.
+    ///
+    /// An occurrence is a substring within edit distance `K` of the needle.
+    /// The leftmost one is returned, extended to the end position with the
+    /// fewest errors.
+    ///
+    /// \param Needle The string to search for.
+    /// \param K The largest number of errors allowed.
+    /// \param Pos Position of the first character to be considered.
+    /// \param MatchLen Receives the length of the occurrence, may be null.
+    ///
+    /// \return The position of the occurrence, or `npos`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType FindApprox(const TString& Needle, size_t K, sizeType Pos = 0,
+        size_t* MatchLen = nullptr) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Scores one query against many candidates.
+    ///
+    /// The query is preprocessed once and reused for every candidate.
+    ///
+    /// \param Query The query.
+    /// \param Candidates The candidates.
+    /// \param K The largest distance of interest, `npos` for no bound.
+    ///
+    /// \return The distance to every candidate, `npos` where it exceeds `K`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static std::vector<size_t> BatchEditDistance(const TString& Query,
+        const std::vector<TString>& Candidates, size_t K = npos);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Sorts strings in byte order.
+    ///
+    /// Multikey quicksort: strings are partitioned on 8 of their bytes at a
+    /// time, cached next to them, and only strings sharing those bytes go on
+    /// to the next 8. Gives the same order as `std::sort` with `operator<`.
+    ///
+    /// \param Strings The strings to sort.
+    /// \param Lcp If not null, receives at index `i` the length of the
+    /// common prefix of the sorted strings `i - 1` and `i`, and 0 at index 0.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static void Sort(std::vector<TString>& Strings,
+        std::vector<size_t>* Lcp = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Sorts strings in byte order using several threads.
+    ///
+    /// The strings are first distributed on their first two bytes, then the
+    /// buckets are sorted as in `Sort` by a pool of threads. Small inputs are
+    /// sorted sequentially.
+    ///
+    /// \param Strings The strings to sort.
+    /// \param Threads Number of threads, 0 for the hardware concurrency.
+    /// \param Lcp If not null, receives the LCP values as in `Sort`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static void ParallelSort(std::vector<TString>& Strings, size_t Threads = 0,
+        std::vector<size_t>* Lcp = nullptr);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Concatenates pieces with a separator between each pair.
+    ///
+    /// The exact length is computed in a first pass over the pieces and the
+    /// result allocated once; a second pass copies them with `memcpy`. When
+    /// the result reaches 16 MiB the pieces are copied in parallel, from a
+    /// table of views built for the purpose.
+    ///
+    /// \param Separator A `TString`, string view, `std::string` or C string.
+    /// \param Pieces Any range of the same.
+    /// \param Threads Number of threads, 0 for the number of cores.
+    ///
+    /// \return The joined string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename S, typename R>
+    static TString Join(const S& Separator, const R& Pieces,
+        size_t Threads = 0);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \param Pos
+    /// \param Len
+    ///
+    /// \return
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString SubStr(sizeType Pos = 0, size_t Len = npos) const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \param Other
+    /// \param Len
+    /// \param Pos
+    ///
+    /// \return
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType _find(const char* Other, size_t Len, sizeType Pos) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \param Other
+    /// \param Len
+    /// \param Pos
+    ///
+    /// \return
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType _rfind(const char* Other, size_t Len, sizeType Pos) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \param Other
+    /// \param Len
+    /// \param Pos
+    ///
+    /// \return
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool _findCompare(const char* Other, size_t Len, sizeType Pos) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \param Other
+    /// \param Len
+    /// \param Pos
+    /// \param IsTrue
+    ///
+    /// \return
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType _findFirstOf(const char* Other, size_t Len, sizeType Pos,
+        bool IsTrue) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \param Other
+    /// \param Len
+    /// \param Pos
+    /// \param IsTrue
+    ///
+    /// \return
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType _findLastOf(const char* Other, size_t Len, sizeType Pos,
+        bool IsTrue) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \param Other
+    /// \param Len
+    /// \param Pos
+    /// \param IsTrue
+    ///
+    /// \return
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool _findOfCompare(const char* Other, size_t Len, sizeType Pos,
+        bool IsTrue) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Scans for every non-overlapping occurrence of a string.
+    ///
+    /// \param Other The string to search for.
+    /// \param Len Length of the string.
+    /// \param Pos Position of the first character to be considered.
+    /// \param Positions Receives the positions, may be null.
+    ///
+    /// \return The number of occurrences.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    size_t _findAll(const char* Other, size_t Len, sizeType Pos,
+        std::vector<sizeType>* Positions) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Splits the candidate positions of a search in chunks.
+    ///
+    /// \param Len Length of the needle.
+    /// \param Threads In: requested threads. Out: threads to use.
+    ///
+    /// \return The chunk size, or 0 when the search should stay sequential.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    size_t _parallelChunk(size_t Len, size_t& Threads) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the first occurrence starting in a range of positions.
+    ///
+    /// \param Other The string to search for.
+    /// \param Len Length of the needle.
+    /// \param Pos First candidate position.
+    /// \param End Position past the last candidate.
+    ///
+    /// \return The position of the occurrence, or `npos`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType _findBefore(const char* Other, size_t Len, sizeType Pos,
+        sizeType End) const;
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \return
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    size_t Length(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \return
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    inline size_t Size(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \return
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    size_t MaxSize(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \param n
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Resize(size_t n);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \param n
+    /// \param Filler
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Resize(sizeType n, char Filler);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief
+    ///
+    /// \return
     ///
     ///////////////////////////////////////////////////////////////////////////
     size_t Capacity(void) const;
@@ -2130,23 +3363,165 @@ public:
     void ShrinkToFit(void);
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Converts the string to lower case.
+    ///
+    /// ASCII letters are converted 16 or 32 bytes at a time. Bytes above
+    /// 0x7F, if any, go through `tolower` for the current locale, which
+    /// leaves UTF-8 sequences unchanged.
+    ///
+    /// \return A reference to this string.
     ///
     ///////////////////////////////////////////////////////////////////////////
     TString& ToLowerCase(void);
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Converts the string to upper case, as `ToLowerCase` does.
+    ///
+    /// \return A reference to this string.
     ///
     ///////////////////////////////////////////////////////////////////////////
     TString& ToUpperCase(void);
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief
+    /// \brief Builds a lower case copy of the string in one allocation.
+    ///
+    /// \return The converted copy.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString ToLowerCopy(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Builds an upper case copy of the string in one allocation.
+    ///
+    /// \return The converted copy.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString ToUpperCopy(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Removes the leading and trailing ASCII whitespace in place.
+    ///
+    /// Whitespace is space, `\t`, `\n`, `\v`, `\f` and `\r`. The capacity
+    /// is kept.
+    ///
+    /// \return A reference to this string.
     ///
     ///////////////////////////////////////////////////////////////////////////
     TString& Trim(void);
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Removes the leading ASCII whitespace in place.
+    ///
+    /// \return A reference to this string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& TrimLeft(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Removes the trailing ASCII whitespace in place.
+    ///
+    /// \return A reference to this string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& TrimRight(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Removes the leading and trailing characters found in a set.
+    ///
+    /// \param Set The characters to remove.
+    ///
+    /// \return A reference to this string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& TrimChars(const TString& Set);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Views the string without its leading and trailing whitespace.
+    ///
+    /// \return A view into this string, valid until it is modified.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::string_view TrimView(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Views the string without its leading whitespace.
+    ///
+    /// \return A view into this string, valid until it is modified.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::string_view TrimLeftView(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Views the string without its trailing whitespace.
+    ///
+    /// \return A view into this string, valid until it is modified.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::string_view TrimRightView(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Views the string without the leading and trailing characters
+    /// found in a set.
+    ///
+    /// \param Set The characters to skip.
+    ///
+    /// \return A view into this string, valid until it is modified.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::string_view TrimCharsView(const TString& Set) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Splits the string on a character, without copying.
+    ///
+    /// Delimiters are found with `memchr`. Adjacent delimiters give empty
+    /// tokens unless `SkipEmpty` is set, and an empty string gives a single
+    /// empty token.
+    ///
+    /// \param Delim The delimiter.
+    /// \param SkipEmpty True to drop empty tokens.
+    /// \param MaxSplits Most delimiters to split on; the rest of the string
+    /// is the last token.
+    ///
+    /// \return A lazy range of views into the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    SplitRange Split(char Delim, bool SkipEmpty = false,
+        sizeType MaxSplits = npos) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Splits the string on a separator, without copying.
+    ///
+    /// Separators are found with the vectorized substring search, and never
+    /// overlap. An empty separator does not split.
+    ///
+    /// \param Sep The separator.
+    /// \param SkipEmpty True to drop empty tokens.
+    /// \param MaxSplits Most separators to split on; the rest of the string
+    /// is the last token.
+    ///
+    /// \return A lazy range of views into the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    SplitRange Split(const TString& Sep, bool SkipEmpty = false,
+        sizeType MaxSplits = npos) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Splits the string on any character of a set, without copying.
+    ///
+    /// Delimiters are found 32 or 16 bytes at a time with AVX2 or SSSE3 when
+    /// the set is ASCII.
+    ///
+    /// \param Set The delimiters.
+    /// \param SkipEmpty True to drop empty tokens.
+    /// \param MaxSplits Most delimiters to split on; the rest of the string
+    /// is the last token.
+    ///
+    /// \return A lazy range of views into the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    SplitRange SplitAny(const TString& Set, bool SkipEmpty = false,
+        sizeType MaxSplits = npos) const;
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief
     ///
@@ -2247,6 +3622,94 @@ private:
     template <typename F>
     TString& _transform(F Func);
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Keeps only a range of the string, in place.
+    ///
+    /// \param Begin First position kept.
+    /// \param End Position one past the last one kept.
+    ///
+    /// \return A reference to this string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString& _keepRange(sizeType Begin, sizeType End);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the range left by trimming a set of characters.
+    ///
+    /// \param Set The characters to skip.
+    /// \param Begin Receives the first position kept.
+    /// \param End Receives the position one past the last one kept.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void _trimRange(const TString& Set, sizeType& Begin, sizeType& End) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Builds a UTF-8 string from UTF-16 or UTF-32, see `FromUtf16`.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    static bool _fromUnits(const T* Data, size_t Len, TString& Out,
+        sizeType* ErrorOffset);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Views a piece given to `Join`.
+    ///
+    /// \param Piece The piece.
+    ///
+    /// \return A view of its bytes.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static std::string_view _view(const TString& Piece);
+    static std::string_view _view(std::string_view Piece);
+    static std::string_view _view(const char* Piece);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Picks the number of threads `Join` copies with.
+    ///
+    /// \param Size Length of the result.
+    /// \param Count Number of pieces.
+    /// \param Threads Number of threads asked for, 0 for the number of cores.
+    ///
+    /// \return The number of threads, 1 to copy sequentially.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static size_t _joinThreads(size_t Size, size_t Count, size_t Threads);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copies pieces and separators in parallel, see `Join`.
+    ///
+    /// \param Separator The separator.
+    /// \param Pieces The pieces.
+    /// \param Threads Number of threads.
+    /// \param Dst The result buffer, large enough for the joined bytes.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static void _join(std::string_view Separator,
+        const std::vector<std::string_view>& Pieces, size_t Threads,
+        char* Dst);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Makes room for bytes past the end.
+    ///
+    /// A buffer that is too small at least doubles, so repeated appends
+    /// copy the string a logarithmic number of times; an empty string is
+    /// sized exactly.
+    ///
+    /// \param Len Number of bytes to be written.
+    ///
+    /// \return The position of the terminating null, where the bytes go.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    char* _reserveTail(size_t Len);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Takes in bytes written after `_reserveTail`.
+    ///
+    /// \param Len Number of bytes written.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void _commitTail(size_t Len);
+
 public:
     ///////////////////////////////////////////////////////////////////////////
     /// \brief
@@ -2257,6 +3720,66 @@ public:
     ///////////////////////////////////////////////////////////////////////////
     static void Swap(TString& A, TString& B);
 
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Hashes the content of the string.
+    ///
+    /// Uses wyhash, a fast non-cryptographic 64-bit hash. The value is stable
+    /// for a given content and seed, embedded NULs included.
+    ///
+    /// \param Seed Value mixed into the hash.
+    ///
+    /// \return The hash of the string.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    uint64_t Hash(uint64_t Seed = 0) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Hashes a range of bytes the same way as `Hash`.
+    ///
+    /// \param Data The bytes to hash, may be null when `Len` is 0.
+    /// \param Len Number of bytes.
+    /// \param Seed Value mixed into the hash.
+    ///
+    /// \return The hash of the bytes.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static uint64_t HashBytes(const void* Data, size_t Len, uint64_t Seed = 0);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Hash functor with a secret seed, for tables whose keys come
+    /// from untrusted input.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    struct SeededHasher
+    {
+        uint64_t Seed;  //<! Value mixed into every hash.
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Uses a seed drawn at random once per process.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        SeededHasher(void);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Uses the given seed.
+        ///
+        /// \param Seed Value mixed into every hash.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        explicit SeededHasher(uint64_t Seed);
+
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief Hashes a string with the seed.
+        ///
+        /// \param Str The string to hash.
+        ///
+        /// \return The hash of the string.
+        ///
+        ///////////////////////////////////////////////////////////////////////
+        size_t operator()(const TString& Str) const;
+    };
+
 public:
     ///////////////////////////////////////////////////////////////////////////
     /// \brief
@@ -2265,6 +3788,77 @@ public:
     operator std::string(void) const;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+template <typename S, typename R>
+TString TString::Join(const S& Separator, const R& Pieces, size_t Threads)
+{
+    const std::string_view Sep = _view(Separator);
+    size_t Count = 0;
+    size_t Size = 0;
+
+    for (const auto& Piece : Pieces)
+        Size += _view(Piece).size() + (Count++ ? Sep.size() : 0);
+
+    TString Result(Size, ReserveTag());
+    Threads = _joinThreads(Size, Count, Threads);
+    if (Threads > 1)
+    {
+        std::vector<std::string_view> Views;
+
+        Views.reserve(Count);
+        for (const auto& Piece : Pieces)
+            Views.push_back(_view(Piece));
+        _join(Sep, Views, Threads, Result._str);
+    }
+    else
+    {
+        char* Dst = Result._str;
+        bool First = true;
+
+        for (const auto& Piece : Pieces)
+        {
+            const std::string_view View = _view(Piece);
+            if (!First && !Sep.empty())
+            {
+                ::memcpy(Dst, Sep.data(), Sep.size());
+                Dst += Sep.size();
+            }
+            if (!View.empty())
+                ::memcpy(Dst, View.data(), View.size());
+            Dst += View.size();
+            First = false;
+        }
+    }
+    Result._strLen = Size;
+    return (Result);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+TString TString::From(T Value)
+{
+    static_assert(std::is_arithmetic<T>::value, "From takes a number");
+    static_assert(!std::is_same<T, wchar_t>::value
+        && !std::is_same<T, char16_t>::value
+        && !std::is_same<T, char32_t>::value,
+        "From does not take wide characters");
+    TString Result;
+
+    if constexpr (std::is_same<T, char>::value)
+        Result.Append(1, Value);
+    else if constexpr (std::is_same<T, bool>::value)
+        Result.Append(Value ? "true" : "false");
+    else if constexpr (std::is_same<T, float>::value)
+        Result.AppendFloat(Value);
+    else if constexpr (std::is_floating_point<T>::value)
+        Result.AppendDouble(static_cast<double>(Value));
+    else if constexpr (std::is_signed<T>::value)
+        Result.AppendInt(static_cast<int64_t>(Value));
+    else
+        Result.AppendUInt(static_cast<uint64_t>(Value));
+    return (Result);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// \brief
 ///
@@ -2361,3 +3955,19 @@ std::istream& getline(std::istream is, TString& Str, char Delim = '\n');
 ///
 ///////////////////////////////////////////////////////////////////////////////
 typedef Ax::TString FString;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Hash support for the standard unordered containers.
+///
+///////////////////////////////////////////////////////////////////////////////
+namespace std
+{
+template <>
+struct hash<Ax::TString>
+{
+    size_t operator()(const Ax::TString& Str) const noexcept
+    {
+        return (static_cast<size_t>(Str.Hash()));
+    }
+};
+} // namespace std
@@ -0,0 +1,768 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Pragma once
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "HashedString.hpp"
+#include "String.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+#if defined(__SSE2__)
+    #include <immintrin.h>
+#endif
+
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Open-addressing hash map from TString keys to values.
+///
+/// Every slot has a control byte holding either a state (empty or deleted)
+/// or the low 7 bits of the hash of its key. Lookups probe groups of 16
+/// control bytes at once, with SSE2 when available, and only compare keys
+/// whose 7-bit fragment matches. Keys can be looked up as `TString`,
+/// `std::string_view`, `const char*` or `THashedString` without building a
+/// `TString`; a `THashedString` built with `Seed()` is not hashed again.
+/// Hashes are seeded per process, which keeps untrusted keys from being
+/// crafted to collide. Pointers to values stay valid until the next
+/// insertion or `Reserve`.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+class TStringMap
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    using sizeType = size_t;        //<! Type alias for size type.
+    static const size_t npos = -1;  //<! The largest possible value.
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs an empty map, without allocating.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TStringMap(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copies a map.
+    ///
+    /// \param Other The map to copy.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TStringMap(const TStringMap& Other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Takes the content of a map, leaving it empty.
+    ///
+    /// \param Other The map to move from.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TStringMap(TStringMap&& Other) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destroys every entry.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    ~TStringMap(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces the content with a copy of another map.
+    ///
+    /// \param Other The map to copy.
+    ///
+    /// \return A reference to this map.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TStringMap& operator=(const TStringMap& Other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces the content with the content of another map.
+    ///
+    /// \param Other The map to move from.
+    ///
+    /// \return A reference to this map.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TStringMap& operator=(TStringMap&& Other) noexcept;
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the value of a key.
+    ///
+    /// \param Key A `TString`, `std::string_view`, `const char*` or
+    /// `THashedString`.
+    ///
+    /// \return A pointer to the value, or null if the key is absent.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename K>
+    V* Find(const K& Key);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the value of a key.
+    ///
+    /// \param Key A `TString`, `std::string_view`, `const char*` or
+    /// `THashedString`.
+    ///
+    /// \return A pointer to the value, or null if the key is absent.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename K>
+    const V* Find(const K& Key) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Tells whether a key is present.
+    ///
+    /// \param Key A `TString`, `std::string_view`, `const char*` or
+    /// `THashedString`.
+    ///
+    /// \return True if the key is present.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename K>
+    bool Contains(const K& Key) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Inserts a key if it is absent.
+    ///
+    /// \param Key A `TString`, `std::string_view`, `const char*` or
+    /// `THashedString`.
+    /// \param Value The value to insert.
+    ///
+    /// \return True if the key was inserted, false if it was already present
+    /// (its value is then left unchanged).
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename K>
+    bool Insert(const K& Key, V Value);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the value of a key, inserting a default one first if
+    /// the key is absent.
+    ///
+    /// \param Key A `TString`, `std::string_view`, `const char*` or
+    /// `THashedString`.
+    ///
+    /// \return A reference to the value.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename K>
+    V& operator[](const K& Key);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Removes a key.
+    ///
+    /// \param Key A `TString`, `std::string_view`, `const char*` or
+    /// `THashedString`.
+    ///
+    /// \return True if the key was present.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename K>
+    bool Erase(const K& Key);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Calls `Func(Key, Value)` for every entry, in no given order.
+    ///
+    /// \param Func The function to call.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename F>
+    void ForEach(F Func) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the number of entries.
+    ///
+    /// \return The number of entries.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    size_t Size(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Tells whether the map has no entry.
+    ///
+    /// \return True if the map is empty.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool IsEmpty(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Removes every entry, keeping the allocated slots.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Clear(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Makes room for a number of entries.
+    ///
+    /// \param n Number of entries that can then be held without growing.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Reserve(size_t n);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the seed of the hashes, to build `THashedString`
+    /// keys whose hash the map can reuse.
+    ///
+    /// \return The seed.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    uint64_t Seed(void) const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A stored key and its value.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        TString Key;    //<! The key.
+        V Value;        //<! The value.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief A key being looked up, with its hash.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    struct KeyRef
+    {
+        const char* Data;   //<! First character of the key.
+        size_t Len;         //<! Length of the key.
+        uint64_t Hash;      //<! Hash of the key.
+    };
+
+    static constexpr size_t _group = 16;    //<! Control bytes per probe.
+    static constexpr int8_t _empty = -128;  //<! Control byte of a free slot.
+    static constexpr int8_t _deleted = -2;  //<! Control byte of a tombstone.
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Builds the lookup form of a key.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    KeyRef _ref(const TString& Key) const;
+    KeyRef _ref(std::string_view Key) const;
+    KeyRef _ref(const char* Key) const;
+    KeyRef _ref(const THashedString& Key) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the bytes of a group equal to a control value.
+    ///
+    /// \param Ctrl First control byte of the group.
+    /// \param Value The control value.
+    ///
+    /// \return A mask with bit `i` set when byte `i` matches.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static uint32_t _match(const int8_t* Ctrl, int8_t Value);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the free (empty or deleted) bytes of a group.
+    ///
+    /// \param Ctrl First control byte of the group.
+    ///
+    /// \return A mask with bit `i` set when byte `i` is free.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    static uint32_t _matchFree(const int8_t* Ctrl);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the slot of a key.
+    ///
+    /// \param Key The key.
+    ///
+    /// \return The slot index, or `npos` if the key is absent.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType _find(const KeyRef& Key) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the first free slot on the probe sequence of a hash.
+    ///
+    /// \param Hash The hash.
+    ///
+    /// \return The slot index; the table must have a free slot.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType _findFree(uint64_t Hash) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Sets the control byte of a slot and its mirror past the end.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void _setCtrl(sizeType Index, int8_t Value);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Inserts an absent key, growing the table if needed.
+    ///
+    /// \param Key The key, already known to be absent.
+    /// \param Value The value.
+    ///
+    /// \return The slot of the new entry.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    sizeType _insert(const KeyRef& Key, V&& Value);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Moves every entry into a table of a new capacity.
+    ///
+    /// \param Capacity The new capacity, a power of two of at least 16.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void _rehash(size_t Capacity);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destroys every entry and frees the table.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void _release(void);
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Private member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<int8_t> _ctrl;      //<! Control bytes, plus a mirrored group.
+    Entry* _slots = nullptr;        //<! Slot storage.
+    size_t _capacity = 0;           //<! Number of slots, a power of two.
+    size_t _size = 0;               //<! Number of entries.
+    size_t _tombstones = 0;         //<! Number of deleted slots.
+    uint64_t _seed;                 //<! Seed of the hashes.
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+TStringMap<V>::TStringMap(void)
+    : _seed(TString::SeededHasher().Seed)
+{}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+TStringMap<V>::TStringMap(const TStringMap& Other)
+    : _seed(Other._seed)
+{
+    Reserve(Other._size);
+    Other.ForEach([this](const TString& Key, const V& Value)
+    {
+        _insert(_ref(Key), V(Value));
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+TStringMap<V>::TStringMap(TStringMap&& Other) noexcept
+    : _ctrl(std::move(Other._ctrl))
+    , _slots(Other._slots)
+    , _capacity(Other._capacity)
+    , _size(Other._size)
+    , _tombstones(Other._tombstones)
+    , _seed(Other._seed)
+{
+    Other._ctrl.clear();
+    Other._slots = nullptr;
+    Other._capacity = 0;
+    Other._size = 0;
+    Other._tombstones = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+TStringMap<V>::~TStringMap(void)
+{
+    _release();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+TStringMap<V>& TStringMap<V>::operator=(const TStringMap& Other)
+{
+    if (this != &Other)
+    {
+        TStringMap Copy(Other);
+        *this = std::move(Copy);
+    }
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+TStringMap<V>& TStringMap<V>::operator=(TStringMap&& Other) noexcept
+{
+    if (this != &Other)
+    {
+        _release();
+        _ctrl = std::move(Other._ctrl);
+        _slots = Other._slots;
+        _capacity = Other._capacity;
+        _size = Other._size;
+        _tombstones = Other._tombstones;
+        _seed = Other._seed;
+        Other._ctrl.clear();
+        Other._slots = nullptr;
+        Other._capacity = 0;
+        Other._size = 0;
+        Other._tombstones = 0;
+    }
+    return (*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+template <typename K>
+V* TStringMap<V>::Find(const K& Key)
+{
+    sizeType Index = _find(_ref(Key));
+    return (Index == npos ? nullptr : &_slots[Index].Value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+template <typename K>
+const V* TStringMap<V>::Find(const K& Key) const
+{
+    sizeType Index = _find(_ref(Key));
+    return (Index == npos ? nullptr : &_slots[Index].Value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+template <typename K>
+bool TStringMap<V>::Contains(const K& Key) const
+{
+    return (_find(_ref(Key)) != npos);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+template <typename K>
+bool TStringMap<V>::Insert(const K& Key, V Value)
+{
+    KeyRef Ref = _ref(Key);
+
+    if (_find(Ref) != npos)
+        return (false);
+    _insert(Ref, std::move(Value));
+    return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+template <typename K>
+V& TStringMap<V>::operator[](const K& Key)
+{
+    KeyRef Ref = _ref(Key);
+    sizeType Index = _find(Ref);
+
+    if (Index == npos)
+        Index = _insert(Ref, V());
+    return (_slots[Index].Value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+template <typename K>
+bool TStringMap<V>::Erase(const K& Key)
+{
+    sizeType Index = _find(_ref(Key));
+
+    if (Index == npos)
+        return (false);
+    _slots[Index].~Entry();
+    _setCtrl(Index, _deleted);
+    _size--;
+    _tombstones++;
+    return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+template <typename F>
+void TStringMap<V>::ForEach(F Func) const
+{
+    for (sizeType i = 0; i < _capacity; ++i)
+    {
+        if (_ctrl[i] >= 0)
+            Func(static_cast<const TString&>(_slots[i].Key),
+                static_cast<const V&>(_slots[i].Value));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+size_t TStringMap<V>::Size(void) const
+{
+    return (_size);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+bool TStringMap<V>::IsEmpty(void) const
+{
+    return (_size == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+void TStringMap<V>::Clear(void)
+{
+    for (sizeType i = 0; i < _capacity; ++i)
+    {
+        if (_ctrl[i] >= 0)
+            _slots[i].~Entry();
+    }
+    std::fill(_ctrl.begin(), _ctrl.end(), _empty);
+    _size = 0;
+    _tombstones = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+void TStringMap<V>::Reserve(size_t n)
+{
+    size_t Capacity = _group;
+
+    while (Capacity - Capacity / 8 < n)
+        Capacity *= 2;
+    if (Capacity > _capacity)
+        _rehash(Capacity);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+uint64_t TStringMap<V>::Seed(void) const
+{
+    return (_seed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+typename TStringMap<V>::KeyRef TStringMap<V>::_ref(const TString& Key) const
+{
+    return (KeyRef{Key.CStr(), Key.Length(), Key.Hash(_seed)});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+typename TStringMap<V>::KeyRef TStringMap<V>::_ref(std::string_view Key)
+    const
+{
+    return (KeyRef{Key.data(), Key.size(),
+        TString::HashBytes(Key.data(), Key.size(), _seed)});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+typename TStringMap<V>::KeyRef TStringMap<V>::_ref(const char* Key) const
+{
+    return (_ref(std::string_view(Key ? Key : "")));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+typename TStringMap<V>::KeyRef TStringMap<V>::_ref(const THashedString& Key)
+    const
+{
+    if (Key.Seed() != _seed)
+        return (_ref(Key.Str()));
+    return (KeyRef{Key.CStr(), Key.Length(), Key.Hash()});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+uint32_t TStringMap<V>::_match(const int8_t* Ctrl, int8_t Value)
+{
+#if defined(__SSE2__)
+    const __m128i Group = _mm_loadu_si128((const __m128i*)Ctrl);
+    return (_mm_movemask_epi8(_mm_cmpeq_epi8(Group, _mm_set1_epi8(Value))));
+#else
+    uint32_t Mask = 0;
+    for (sizeType i = 0; i < _group; ++i)
+        Mask |= uint32_t(Ctrl[i] == Value) << i;
+    return (Mask);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+uint32_t TStringMap<V>::_matchFree(const int8_t* Ctrl)
+{
+#if defined(__SSE2__)
+    // Free states are negative, full slots hold a 7-bit fragment.
+    return (_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)Ctrl)));
+#else
+    uint32_t Mask = 0;
+    for (sizeType i = 0; i < _group; ++i)
+        Mask |= uint32_t(Ctrl[i] < 0) << i;
+    return (Mask);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+typename TStringMap<V>::sizeType TStringMap<V>::_find(const KeyRef& Key)
+    const
+{
+    if (_size == 0)
+        return (npos);
+
+    const size_t Mask = _capacity - 1;
+    const int8_t Fragment = static_cast<int8_t>(Key.Hash & 0x7F);
+    sizeType Pos = (Key.Hash >> 7) & Mask;
+
+    // Probing by whole groups, with a step growing by one group each time,
+    // visits every group of a power-of-two table.
+    for (size_t Step = _group;; Step += _group)
+    {
+        const int8_t* Ctrl = _ctrl.data() + Pos;
+        for (uint32_t Match = _match(Ctrl, Fragment); Match;
+            Match &= Match - 1)
+        {
+            sizeType i = (Pos + __builtin_ctz(Match)) & Mask;
+            const TString& Stored = _slots[i].Key;
+            if (Stored.Length() == Key.Len && (Key.Len == 0 ||
+                ::memcmp(Stored.CStr(), Key.Data, Key.Len) == 0))
+                return (i);
+        }
+        if (_match(Ctrl, _empty))
+            return (npos);
+        Pos = (Pos + Step) & Mask;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+typename TStringMap<V>::sizeType TStringMap<V>::_findFree(uint64_t Hash) const
+{
+    const size_t Mask = _capacity - 1;
+    sizeType Pos = (Hash >> 7) & Mask;
+
+    for (size_t Step = _group;; Step += _group)
+    {
+        uint32_t Free = _matchFree(_ctrl.data() + Pos);
+        if (Free)
+            return ((Pos + __builtin_ctz(Free)) & Mask);
+        Pos = (Pos + Step) & Mask;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+void TStringMap<V>::_setCtrl(sizeType Index, int8_t Value)
+{
+    _ctrl[Index] = Value;
+    if (Index < _group)
+        _ctrl[_capacity + Index] = Value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+typename TStringMap<V>::sizeType TStringMap<V>::_insert(const KeyRef& Key,
+    V&& Value)
+{
+    // The key is copied first: it may point into an entry moved by a rehash.
+    TString Stored;
+    Stored.Append(Key.Data, Key.Len);
+
+    // Keep at least one slot in eight empty, so that lookups of absent keys
+    // stop early; tombstones are cleaned up without growing when they take
+    // most of that room.
+    if (_capacity == 0)
+        _rehash(_group);
+    else if (_size + _tombstones + 1 > _capacity - _capacity / 8)
+        _rehash(_size + 1 > _capacity / 2 ? _capacity * 2 : _capacity);
+
+    sizeType Index = _findFree(Key.Hash);
+    new (&_slots[Index]) Entry{std::move(Stored), std::move(Value)};
+    if (_ctrl[Index] == _deleted)
+        _tombstones--;
+    _setCtrl(Index, static_cast<int8_t>(Key.Hash & 0x7F));
+    _size++;
+    return (Index);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+void TStringMap<V>::_rehash(size_t Capacity)
+{
+    std::vector<int8_t> OldCtrl(Capacity + _group, _empty);
+    Entry* OldSlots = std::allocator<Entry>().allocate(Capacity);
+    const size_t OldCapacity = _capacity;
+
+    OldCtrl.swap(_ctrl);
+    std::swap(OldSlots, _slots);
+    _capacity = Capacity;
+    _tombstones = 0;
+    for (sizeType i = 0; i < OldCapacity; ++i)
+    {
+        if (OldCtrl[i] < 0)
+            continue;
+        Entry& Moved = OldSlots[i];
+        uint64_t Hash = Moved.Key.Hash(_seed);
+        sizeType Index = _findFree(Hash);
+        new (&_slots[Index]) Entry{std::move(Moved.Key),
+            std::move(Moved.Value)};
+        _setCtrl(Index, static_cast<int8_t>(Hash & 0x7F));
+        Moved.~Entry();
+    }
+    if (OldSlots)
+        std::allocator<Entry>().deallocate(OldSlots, OldCapacity);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+void TStringMap<V>::_release(void)
+{
+    if (!_slots)
+        return;
+    Clear();
+    std::allocator<Entry>().deallocate(_slots, _capacity);
+    _slots = nullptr;
+    _ctrl.clear();
+    _capacity = 0;
+}
+
+} // namespace Ax
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Export to global namespace.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <typename V>
+using FStringMap = Ax::TStringMap<V>;
@@ -0,0 +1,400 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "SuffixIndex.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+///////////////////////////////////////////////////////////////////////////////
+// Namespace Ax
+///////////////////////////////////////////////////////////////////////////////
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+using sizeType = size_t;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Builds the suffix array of `S`, whose symbols are in [0, Upper].
+///
+/// SA-IS: the suffixes are classified as S or L type, the leftmost S-type
+/// (LMS) substrings are sorted by induction, named, and the reduced string of
+/// names is solved recursively when the names are not unique.
+///
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static std::vector<sizeType> _saIs(const T* S, size_t N, size_t Upper)
+{
+    const sizeType None = TSuffixIndex::npos;
+    std::vector<sizeType> Sa(N);
+
+    if (N < 2)
+        return (Sa);
+    if (N == 2)
+    {
+        Sa[0] = S[0] < S[1] ? 0 : 1;
+        Sa[1] = 1 - Sa[0];
+        return (Sa);
+    }
+
+    std::vector<bool> IsS(N, false);
+    for (sizeType i = N - 1; i-- > 0;)
+        IsS[i] = S[i] == S[i + 1] ? IsS[i + 1] : S[i] < S[i + 1];
+
+    // Bucket boundaries: SumL[c] is where the L-type suffixes starting with
+    // c begin, SumS[c] where the S-type ones do. An S-type symbol is always
+    // followed by a larger one, so it is never `Upper`.
+    std::vector<sizeType> SumL(Upper + 1, 0), SumS(Upper + 1, 0);
+    for (sizeType i = 0; i < N; ++i)
+    {
+        if (!IsS[i])
+            SumS[S[i]]++;
+        else
+            SumL[S[i] + 1]++;
+    }
+    for (sizeType c = 0; c <= Upper; ++c)
+    {
+        SumS[c] += SumL[c];
+        if (c < Upper)
+            SumL[c + 1] += SumS[c];
+    }
+
+    std::vector<sizeType> Buffer(Upper + 1);
+    auto Induce = [&](const std::vector<sizeType>& Lms)
+    {
+        std::fill(Sa.begin(), Sa.end(), None);
+        Buffer = SumS;
+        for (sizeType d : Lms)
+            Sa[Buffer[S[d]]++] = d;
+        Buffer = SumL;
+        Sa[Buffer[S[N - 1]]++] = N - 1;
+        for (sizeType i = 0; i < N; ++i)
+        {
+            sizeType v = Sa[i];
+            if (v != None && v >= 1 && !IsS[v - 1])
+                Sa[Buffer[S[v - 1]]++] = v - 1;
+        }
+        Buffer = SumL;
+        for (sizeType i = N; i-- > 0;)
+        {
+            sizeType v = Sa[i];
+            if (v != None && v >= 1 && IsS[v - 1])
+                Sa[--Buffer[S[v - 1] + 1]] = v - 1;
+        }
+    };
+
+    std::vector<sizeType> LmsMap(N + 1, None);
+    std::vector<sizeType> Lms;
+    for (sizeType i = 1; i < N; ++i)
+    {
+        if (!IsS[i - 1] && IsS[i])
+        {
+            LmsMap[i] = Lms.size();
+            Lms.push_back(i);
+        }
+    }
+
+    Induce(Lms);
+    if (Lms.empty())
+        return (Sa);
+
+    const size_t M = Lms.size();
+    std::vector<sizeType> SortedLms;
+    SortedLms.reserve(M);
+    for (sizeType v : Sa)
+    {
+        if (LmsMap[v] != None)
+            SortedLms.push_back(v);
+    }
+
+    // Name the LMS substrings; equal substrings get the same name.
+    std::vector<sizeType> Reduced(M);
+    size_t ReducedUpper = 0;
+    Reduced[LmsMap[SortedLms[0]]] = 0;
+    for (sizeType i = 1; i < M; ++i)
+    {
+        sizeType l = SortedLms[i - 1];
+        sizeType r = SortedLms[i];
+        sizeType EndL = LmsMap[l] + 1 < M ? Lms[LmsMap[l] + 1] : N;
+        sizeType EndR = LmsMap[r] + 1 < M ? Lms[LmsMap[r] + 1] : N;
+        bool Same = EndL - l == EndR - r;
+
+        if (Same)
+        {
+            while (l < EndL && S[l] == S[r])
+            {
+                l++;
+                r++;
+            }
+            if (l == N || S[l] != S[r])
+                Same = false;
+        }
+        if (!Same)
+            ReducedUpper++;
+        Reduced[LmsMap[SortedLms[i]]] = ReducedUpper;
+    }
+
+    std::vector<sizeType> ReducedSa = _saIs(Reduced.data(), M, ReducedUpper);
+    for (sizeType i = 0; i < M; ++i)
+        SortedLms[i] = Lms[ReducedSa[i]];
+    Induce(SortedLms);
+    return (Sa);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TSuffixIndex::TSuffixIndex(void)
+{}
+
+///////////////////////////////////////////////////////////////////////////////
+TSuffixIndex::TSuffixIndex(const TString& Text)
+{
+    Build(Text);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TSuffixIndex::Build(const TString& Text)
+{
+    const unsigned char* Str =
+        reinterpret_cast<const unsigned char*>(Text.CStr());
+    const size_t N = Text.Length();
+
+    _text = Text;
+    _sa = _saIs(Str, N, 255);
+
+    // Kasai: the LCP of a suffix with its predecessor in rank order drops by
+    // at most one from one text position to the next.
+    std::vector<sizeType> Rank(N);
+    for (sizeType i = 0; i < N; ++i)
+        Rank[_sa[i]] = i;
+    _lcp.assign(N, 0);
+    for (sizeType i = 0, h = 0; i < N; ++i)
+    {
+        if (h > 0)
+            h--;
+        if (Rank[i] == 0)
+            continue;
+        sizeType j = _sa[Rank[i] - 1];
+        while (i + h < N && j + h < N && Str[i + h] == Str[j + h])
+            h++;
+        _lcp[Rank[i]] = h;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const TString& TSuffixIndex::Text(void) const
+{
+    return (_text);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const std::vector<sizeType>& TSuffixIndex::SuffixArray(void) const
+{
+    return (_sa);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const std::vector<sizeType>& TSuffixIndex::LcpArray(void) const
+{
+    return (_lcp);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t TSuffixIndex::Count(const TString& Pattern) const
+{
+    if (Pattern.Length() == 0)
+        return (0);
+    std::pair<sizeType, sizeType> Range = _range(Pattern);
+    return (Range.second - Range.first);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<sizeType> TSuffixIndex::Locate(const TString& Pattern) const
+{
+    std::vector<sizeType> Positions;
+
+    if (Pattern.Length() == 0)
+        return (Positions);
+    std::pair<sizeType, sizeType> Range = _range(Pattern);
+    Positions.assign(_sa.begin() + Range.first, _sa.begin() + Range.second);
+    std::sort(Positions.begin(), Positions.end());
+    return (Positions);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TString TSuffixIndex::LongestRepeatedSubstring(sizeType* Pos) const
+{
+    sizeType Best = 0;
+
+    // `_lcp[0]` has no predecessor and is never a candidate.
+    for (sizeType i = 1; i < _lcp.size(); ++i)
+    {
+        if (_lcp[i] > (Best ? _lcp[Best] : 0))
+            Best = i;
+    }
+    if (Best == 0)
+    {
+        if (Pos)
+            *Pos = npos;
+        return (TString());
+    }
+    sizeType Start = std::min(_sa[Best - 1], _sa[Best]);
+    if (Pos)
+        *Pos = Start;
+    return (TString(_text, Start, _lcp[Best]));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::pair<sizeType, sizeType> TSuffixIndex::_range(const TString& Pattern)
+    const
+{
+    const char* Text = _text.CStr();
+    const char* Str = Pattern.CStr();
+    const size_t N = _sa.size();
+    const size_t M = Pattern.Length();
+
+    // Compares the suffix at rank `r` with the pattern, ignoring what comes
+    // after the first `M` characters of the suffix.
+    auto Compare = [&](sizeType r)
+    {
+        const size_t Len = N - _sa[r];
+        int Diff = ::memcmp(Text + _sa[r], Str, std::min(Len, M));
+        if (Diff != 0)
+            return (Diff);
+        return (Len < M ? -1 : 0);
+    };
+
+    sizeType Low = 0;
+    sizeType High = N;
+    while (Low < High)
+    {
+        sizeType Mid = Low + (High - Low) / 2;
+        if (Compare(Mid) < 0)
+            Low = Mid + 1;
+        else
+            High = Mid;
+    }
+    sizeType First = Low;
+    High = N;
+    while (Low < High)
+    {
+        sizeType Mid = Low + (High - Low) / 2;
+        if (Compare(Mid) <= 0)
+            Low = Mid + 1;
+        else
+            High = Mid;
+    }
+    return (std::make_pair(First, Low));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// File layout: the "AXSI" tag, a version, the width of the stored integers,
+// the text length, then the text, the suffix array and the LCP array.
+///////////////////////////////////////////////////////////////////////////////
+static const char _indexTag[4] = {'A', 'X', 'S', 'I'};
+static const uint32_t _indexVersion = 1;
+
+///////////////////////////////////////////////////////////////////////////////
+bool TSuffixIndex::Save(const TString& Path) const
+{
+    std::FILE* File = std::fopen(Path.CStr(), "wb");
+    const uint32_t Width = sizeof(sizeType);
+    const uint64_t N = _sa.size();
+    bool Ok;
+
+    if (!File)
+        return (false);
+    Ok = std::fwrite(_indexTag, 1, 4, File) == 4
+        && std::fwrite(&_indexVersion, sizeof(uint32_t), 1, File) == 1
+        && std::fwrite(&Width, sizeof(uint32_t), 1, File) == 1
+        && std::fwrite(&N, sizeof(uint64_t), 1, File) == 1
+        && std::fwrite(_text.CStr(), 1, N, File) == N
+        && std::fwrite(_sa.data(), sizeof(sizeType), N, File) == N
+        && std::fwrite(_lcp.data(), sizeof(sizeType), N, File) == N;
+    return (std::fclose(File) == 0 && Ok);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool TSuffixIndex::Load(const TString& Path)
+{
+    std::FILE* File = std::fopen(Path.CStr(), "rb");
+    char Tag[4];
+    uint32_t Version = 0;
+    uint32_t Width = 0;
+    uint64_t N = 0;
+
+    if (!File)
+        return (false);
+    bool Ok = std::fread(Tag, 1, 4, File) == 4
+        && ::memcmp(Tag, _indexTag, 4) == 0
+        && std::fread(&Version, sizeof(uint32_t), 1, File) == 1
+        && Version == _indexVersion
+        && std::fread(&Width, sizeof(uint32_t), 1, File) == 1
+        && Width == sizeof(sizeType)
+        && std::fread(&N, sizeof(uint64_t), 1, File) == 1;
+
+    // Check the file is large enough before allocating for it.
+    long Start = Ok ? std::ftell(File) : -1;
+    Ok = Ok && Start >= 0 && std::fseek(File, 0, SEEK_END) == 0;
+    long End = Ok ? std::ftell(File) : -1;
+    Ok = Ok && End >= Start
+        && N <= uint64_t(End - Start)
+        && uint64_t(End - Start) == N * (2 * sizeof(sizeType) + 1)
+        && std::fseek(File, Start, SEEK_SET) == 0;
+
+    TString Text(Ok ? N : 0, '\0');
+    std::vector<sizeType> Sa(Ok ? N : 0);
+    std::vector<sizeType> Lcp(Ok ? N : 0);
+    Ok = Ok
+        && (N == 0 || std::fread(&Text[0], 1, N, File) == N)
+        && std::fread(Sa.data(), sizeof(sizeType), N, File) == N
+        && std::fread(Lcp.data(), sizeof(sizeType), N, File) == N;
+    std::fclose(File);
+
+    // The suffix array must be a permutation, a common prefix cannot run
+    // past the end of the text, and the first suffix has no predecessor to
+    // share one with.
+    Ok = Ok && (N == 0 || Lcp[0] == 0);
+    std::vector<bool> Seen(Ok ? N : 0, false);
+    for (sizeType i = 0; Ok && i < N; ++i)
+    {
+        Ok = Sa[i] < N && !Seen[Sa[i]] && Lcp[i] <= N - Sa[i];
+        if (Ok)
+            Seen[Sa[i]] = true;
+    }
+    if (!Ok)
+        return (false);
+    _text.Swap(Text);
+    _sa.swap(Sa);
+    _lcp.swap(Lcp);
+    return (true);
+}
+
+} // namespace Ax
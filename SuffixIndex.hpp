@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Pragma once
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "String.hpp"
+#include <vector>
+#include <utility>
+
+namespace Ax
+{
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Suffix array index over an immutable text.
+///
+/// The suffix array is built in linear time with SA-IS, and the LCP array
+/// with Kasai's algorithm. Pattern queries are binary searches over the
+/// sorted suffixes and cost O(m log n). The index keeps its own copy of the
+/// text and can be saved to a file and loaded back without being rebuilt.
+///
+///////////////////////////////////////////////////////////////////////////////
+class TSuffixIndex
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    using sizeType = size_t;        //<! Type alias for size type.
+    static const size_t npos = -1;  //<! The largest possible value.
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs an index over the empty text.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TSuffixIndex(void);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs an index over a text.
+    ///
+    /// \param Text The text to index.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TSuffixIndex(const TString& Text);
+
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces the indexed text and rebuilds the index.
+    ///
+    /// \param Text The text to index.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    void Build(const TString& Text);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the indexed text.
+    ///
+    /// \return The text.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    const TString& Text(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the suffix array.
+    ///
+    /// \return The starting positions of the suffixes, in sorted order.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    const std::vector<sizeType>& SuffixArray(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Retrieves the LCP array.
+    ///
+    /// \return At index `i`, the length of the longest common prefix of the
+    /// suffixes at ranks `i - 1` and `i`; 0 at index 0.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    const std::vector<sizeType>& LcpArray(void) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Counts the occurrences of a pattern, overlapping ones included.
+    ///
+    /// \param Pattern The pattern to look for.
+    ///
+    /// \return The number of occurrences, 0 for an empty pattern.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    size_t Count(const TString& Pattern) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the occurrences of a pattern, overlapping ones included.
+    ///
+    /// \param Pattern The pattern to look for.
+    ///
+    /// \return The positions of the occurrences, in increasing order.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<sizeType> Locate(const TString& Pattern) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the longest substring occurring at least twice.
+    ///
+    /// \param Pos If not null, receives the position of its leftmost
+    /// occurrence among the two adjacent suffixes sharing it.
+    ///
+    /// \return The substring, empty if no character repeats.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString LongestRepeatedSubstring(sizeType* Pos = nullptr) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Writes the text and the index to a file.
+    ///
+    /// \param Path Path of the file.
+    ///
+    /// \return True on success.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool Save(const TString& Path) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Reads an index written by `Save`.
+    ///
+    /// The index is left unchanged if the file cannot be read or is not a
+    /// valid index.
+    ///
+    /// \param Path Path of the file.
+    ///
+    /// \return True on success.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    bool Load(const TString& Path);
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the rank range of the suffixes starting with a pattern.
+    ///
+    /// \param Pattern The pattern, not empty.
+    ///
+    /// \return The first rank and the rank one past the last.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    std::pair<sizeType, sizeType> _range(const TString& Pattern) const;
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Private member data.
+    ///
+    ///////////////////////////////////////////////////////////////////////////
+    TString _text;                  //<! The indexed text.
+    std::vector<sizeType> _sa;      //<! Suffix array.
+    std::vector<sizeType> _lcp;     //<! LCP array.
+};
+
+} // namespace Ax
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Export to global namespace.
+///
+///////////////////////////////////////////////////////////////////////////////
+typedef Ax::TSuffixIndex FSuffixIndex;
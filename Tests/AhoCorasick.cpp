@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "AhoCorasick.hpp"
+#include "Check.hpp"
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TAhoCorasick;
+using Ax::TString;
+using FMatch = TAhoCorasick::Match;
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomBytes(std::mt19937& Rng, size_t Len)
+{
+    static const char Bytes[] = {'a', 'b', 'c', '\0', '\xFF'};
+    std::string Str;
+
+    for (size_t i = 0; i < Len; ++i)
+        Str += Bytes[Rng() % (Rng() % 4 ? 3 : 5)];
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Occurrences are sorted by end, then longest first, then identifier.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _sort(std::vector<FMatch>& Matches,
+    const std::vector<std::string>& Patterns)
+{
+    std::sort(Matches.begin(), Matches.end(),
+        [&](const FMatch& A, const FMatch& B)
+        {
+            const size_t LenA = Patterns[A.Pattern].size();
+            const size_t LenB = Patterns[B.Pattern].size();
+
+            return (std::make_tuple(A.Position + LenA, LenB, A.Pattern)
+                < std::make_tuple(B.Position + LenB, LenA, B.Pattern));
+        });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static std::vector<FMatch> _bruteForce(const std::string& Text,
+    const std::vector<std::string>& Patterns)
+{
+    std::vector<FMatch> Matches;
+
+    for (size_t p = 0; p < Patterns.size(); ++p)
+    {
+        const std::string& Pattern = Patterns[p];
+
+        for (size_t i = 0; !Pattern.empty()
+            && i + Pattern.size() <= Text.size(); ++i)
+        {
+            if (Text.compare(i, Pattern.size(), Pattern) == 0)
+                Matches.push_back(FMatch{i, p});
+        }
+    }
+    _sort(Matches, Patterns);
+    return (Matches);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static bool _same(const std::vector<FMatch>& A, const std::vector<FMatch>& B)
+{
+    if (A.size() != B.size())
+        return (false);
+    for (size_t i = 0; i < A.size(); ++i)
+    {
+        if (A[i].Position != B[i].Position || A[i].Pattern != B[i].Pattern)
+            return (false);
+    }
+    return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Random pattern sets, overlapping and duplicated, against a brute-force
+/// scan; the same text fed to a scanner in random chunks must report the
+/// same occurrences.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(26);
+
+    for (int Round = 0; Round < 500; ++Round)
+    {
+        std::vector<std::string> Patterns(1 + Rng() % 20);
+        TAhoCorasick Automaton;
+
+        for (std::string& Pattern : Patterns)
+        {
+            Pattern = _randomBytes(Rng, Rng() % 6);
+            AX_CHECK(Automaton.Add(Pattern.data(), Pattern.size())
+                == size_t(&Pattern - Patterns.data()));
+        }
+        Automaton.Build();
+        AX_CHECK(Automaton.PatternCount() == Patterns.size());
+
+        const std::string Text = _randomBytes(Rng, Rng() % 300);
+        const std::vector<FMatch> Expected = _bruteForce(Text, Patterns);
+        std::vector<FMatch> Found = Automaton.FindAll(MakeString(Text));
+
+        for (size_t i = 1; i < Found.size(); ++i)
+        {
+            const size_t PrevLen = Patterns[Found[i - 1].Pattern].size();
+            const size_t Len = Patterns[Found[i].Pattern].size();
+            const size_t PrevEnd = Found[i - 1].Position + PrevLen;
+            const size_t End = Found[i].Position + Len;
+
+            AX_CHECK(PrevEnd < End || (PrevEnd == End && PrevLen >= Len));
+        }
+        _sort(Found, Patterns);
+        AX_CHECK(_same(Found, Expected));
+        AX_CHECK(Automaton.ContainsAny(MakeString(Text)) == !Expected.empty());
+
+        TAhoCorasick::Scanner Scanner(Automaton);
+        std::vector<FMatch> Streamed;
+
+        for (size_t At = 0; At < Text.size();)
+        {
+            const size_t Len = std::min<size_t>(Rng() % 17, Text.size() - At);
+
+            Scanner.Feed(Text.data() + At, Len, Streamed);
+            At += Len;
+        }
+        AX_CHECK(Scanner.Offset() == Text.size());
+        _sort(Streamed, Patterns);
+        AX_CHECK(_same(Streamed, Expected));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testBasics(void)
+{
+    TAhoCorasick Automaton({TString("he"), TString("she"), TString("his"),
+        TString("hers")});
+    const std::vector<FMatch> Found = Automaton.FindAll(TString("ushers"));
+
+    AX_CHECK(Found.size() == 3);
+    AX_CHECK(Found[0].Position == 1 && Found[0].Pattern == 1);
+    AX_CHECK(Found[1].Position == 2 && Found[1].Pattern == 0);
+    AX_CHECK(Found[2].Position == 2 && Found[2].Pattern == 3);
+    AX_CHECK(Automaton.ContainsAny(TString("hi there")));
+    AX_CHECK(!Automaton.ContainsAny(TString("xyz")));
+
+    TAhoCorasick::Scanner Scanner(Automaton);
+    std::vector<FMatch> Streamed;
+
+    Scanner.Feed(TString("us"), Streamed);
+    Scanner.Feed(TString("h"), Streamed);
+    Scanner.Reset();
+    Scanner.Feed(TString("e"), Streamed);
+    AX_CHECK(Streamed.empty() && Scanner.Offset() == 1);
+
+    Automaton.Clear();
+    AX_CHECK(Automaton.PatternCount() == 0);
+    Automaton.Add(TString());
+    Automaton.Build();
+    AX_CHECK(Automaton.FindAll(TString("abc")).empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testBasics();
+    _testRandom();
+    std::puts("ok");
+    return (0);
+}
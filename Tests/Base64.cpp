@@ -0,0 +1,235 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+// The AVX2 kernels are file-local, so this test builds the sources in
+// instead of linking the library.
+#include "../String.cpp"
+#include "../Base64.cpp"
+#include "Check.hpp"
+#include "CountNew.hpp"
+#include <random>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+using Ax::sizeType;
+using Alphabet = TString::Base64Alphabet;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Reference encoder, one group at a time.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::string _encode(const std::string& Bytes, bool Url, bool Padding)
+{
+    const char* Digits = Url
+        ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+        : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string Out;
+
+    for (size_t i = 0; i < Bytes.size(); i += 3)
+    {
+        const size_t Left = std::min<size_t>(3, Bytes.size() - i);
+        uint32_t Group = 0;
+        for (size_t k = 0; k < 3; ++k)
+            Group = (Group << 8) | (k < Left ? (unsigned char)Bytes[i + k] : 0);
+        for (size_t k = 0; k < 4; ++k)
+        {
+            if (k <= Left)
+                Out += Digits[(Group >> (18 - 6 * k)) & 0x3F];
+            else if (Padding)
+                Out += '=';
+        }
+    }
+    return (Out);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomBytes(std::mt19937& Rng, size_t Len)
+{
+    std::string Bytes(Len, '\0');
+
+    for (char& Ch : Bytes)
+        Ch = char(Rng());
+    return (Bytes);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Encodes and decodes random buffers of every small length with
+/// both alphabets, with and without padding, whole and piece by piece;
+/// `ToBase64` must allocate once.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRoundTrip(void)
+{
+    std::mt19937 Rng(3);
+
+    for (size_t Len = 0; Len < 400; ++Len)
+    {
+        const std::string Bytes = _randomBytes(Rng, Len);
+        for (int Mode = 0; Mode < 4; ++Mode)
+        {
+            const bool Url = Mode & 1;
+            const bool Padding = Mode & 2;
+            const Alphabet Digits = Url ? Alphabet::Url : Alphabet::Standard;
+            const std::string Expected = _encode(Bytes, Url, Padding);
+
+            const TString Str = MakeString(Bytes);
+            TString Encoded;
+            const TAllocations Made = CountAllocations([&]()
+            {
+                Encoded = Str.ToBase64(Digits, Padding);
+            });
+            AX_CHECK(ToStd(Encoded) == Expected);
+            AX_CHECK(Made.NewArray == 1);
+            TString Decoded;
+            sizeType Offset = 0;
+            AX_CHECK(TString::FromBase64(Expected.data(), Expected.size(),
+                Decoded, Digits, &Offset));
+            AX_CHECK(ToStd(Decoded) == Bytes);
+
+            Ax::TBase64Encoder Encoder(Digits, Padding);
+            Ax::TBase64Decoder Decoder(Digits);
+            TString Streamed;
+            TString Restored;
+            for (size_t At = 0; At < Len;)
+            {
+                const size_t Piece = std::min<size_t>(Rng() % 50, Len - At);
+                Encoder.Update(Bytes.data() + At, Piece, Streamed);
+                At += Piece;
+            }
+            Encoder.Finish(Streamed);
+            AX_CHECK(ToStd(Streamed) == Expected);
+            for (size_t At = 0; At < Expected.size();)
+            {
+                const size_t Piece =
+                    std::min<size_t>(Rng() % 50, Expected.size() - At);
+                AX_CHECK(Decoder.Update(Expected.data() + At, Piece,
+                    Restored));
+                At += Piece;
+            }
+            AX_CHECK(Decoder.Finish(Restored));
+            AX_CHECK(ToStd(Restored) == Bytes);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A digit outside the alphabet is reported at its offset, by the
+/// one-shot and the streaming decoder, and leaves the output untouched.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testInvalidDigits(void)
+{
+    std::mt19937 Rng(5);
+    const char Bad[] = {'*', '\n', ' ', '\0', '\x80', '-', '+'};
+
+    for (int Round = 0; Round < 3000; ++Round)
+    {
+        const bool Url = Round & 1;
+        const Alphabet Digits = Url ? Alphabet::Url : Alphabet::Standard;
+        std::string Text = _encode(_randomBytes(Rng, 1 + Rng() % 300), Url,
+            false);
+        const size_t At = Rng() % Text.size();
+        const char Ch = Bad[Rng() % sizeof(Bad)];
+        if ((Url && Ch == '-') || (!Url && Ch == '+'))
+            continue;
+        Text[At] = Ch;
+
+        TString Out = MakeString("kept");
+        sizeType Offset = 0;
+        AX_CHECK(!TString::FromBase64(Text.data(), Text.size(), Out, Digits,
+            &Offset));
+        AX_CHECK(Offset == At);
+        AX_CHECK(ToStd(Out) == "kept");
+
+        Ax::TBase64Decoder Decoder(Digits);
+        TString Streamed;
+        bool Valid = true;
+        for (size_t Pos = 0; Pos < Text.size(); Pos += 7)
+        {
+            Valid = Decoder.Update(Text.data() + Pos,
+                std::min<size_t>(7, Text.size() - Pos), Streamed) && Valid;
+        }
+        Valid = Decoder.Finish(Streamed) && Valid;
+        AX_CHECK(!Valid && Decoder.ErrorOffset() == At);
+    }
+
+    // Padding and the unused bits of the last digit are checked.
+    TString Out;
+    AX_CHECK(TString::FromBase64("QQ==", 4, Out) && ToStd(Out) == "A");
+    AX_CHECK(!TString::FromBase64("QR==", 4, Out));
+    AX_CHECK(!TString::FromBase64("QQ=", 3, Out));
+    AX_CHECK(!TString::FromBase64("Q===", 4, Out));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief When the CPU has AVX2, the vector kernels do the bulk of the work
+/// and agree with the scalar loops.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testVectorKernels(void)
+{
+#if defined(AX_AVX2_KERNELS)
+    if (!Ax::_cpuHasAvx2())
+        return;
+
+    std::mt19937 Rng(9);
+    for (int Round = 0; Round < 200; ++Round)
+    {
+        const bool Url = Round & 1;
+        const std::string Bytes = _randomBytes(Rng, 300 + Rng() % 3000);
+        const size_t Groups = Bytes.size() / 3 * 3;
+        const std::string Expected = _encode(Bytes.substr(0, Groups), Url,
+            false);
+
+        std::string Digits(Expected.size() + 32, '\0');
+        const size_t Encoded = Ax::_base64EncodeAvx2(
+            (const unsigned char*)Bytes.data(), Groups, &Digits[0], Url);
+        AX_CHECK(Encoded % 24 == 0 && Encoded + 28 > Groups);
+        AX_CHECK(Digits.compare(0, Encoded / 3 * 4, Expected, 0,
+            Encoded / 3 * 4) == 0);
+
+        std::string Back(Groups + 32, '\0');
+        const size_t Decoded = Ax::_base64DecodeAvx2(Expected.data(),
+            Expected.size(), (unsigned char*)&Back[0], Url, Back.size());
+        AX_CHECK(Decoded % 32 == 0 && Decoded + 32 > Expected.size());
+        AX_CHECK(Back.compare(0, Decoded / 4 * 3, Bytes, 0,
+            Decoded / 4 * 3) == 0);
+    }
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRoundTrip();
+    _testInvalidDigits();
+    _testVectorKernels();
+    std::puts("ok");
+    return (0);
+}
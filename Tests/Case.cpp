@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "CountNew.hpp"
+#include <cctype>
+#include <clocale>
+#include <random>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Byte-wise conversion in the current locale, which the kernels must
+/// reproduce.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::string _reference(std::string Str, bool Upper)
+{
+    for (char& Ch : Str)
+    {
+        const int Byte = static_cast<unsigned char>(Ch);
+
+        Ch = static_cast<char>(Upper ? std::toupper(Byte)
+            : std::tolower(Byte));
+    }
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Every length up to past two AVX2 blocks, with and without bytes above
+/// 0x7F, in place and as copies.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(40);
+
+    for (size_t Len = 0; Len < 300; ++Len)
+    {
+        for (int Round = 0; Round < 8; ++Round)
+        {
+            const bool Ascii = Round % 2 == 0;
+            std::string Bytes;
+
+            for (size_t i = 0; i < Len; ++i)
+            {
+                const unsigned Byte = Rng() % (Ascii ? 128 : 256);
+
+                Bytes += static_cast<char>(Byte ? Byte : 'a');
+            }
+
+            const TString Str = MakeString(Bytes);
+
+            for (bool Upper : {false, true})
+            {
+                const std::string Expected = _reference(Bytes, Upper);
+                TString Copy;
+                TString InPlace = Str;
+
+                const TAllocations Convert = CountAllocations([&]()
+                {
+                    Upper ? InPlace.ToUpperCase() : InPlace.ToLowerCase();
+                });
+                const TAllocations Build = CountAllocations([&]()
+                {
+                    Copy = Upper ? Str.ToUpperCopy() : Str.ToLowerCopy();
+                });
+
+                AX_CHECK(ToStd(InPlace) == Expected);
+                AX_CHECK(ToStd(Copy) == Expected);
+                AX_CHECK(ToStd(Str) == Bytes);
+                AX_CHECK(Convert.New == 0 && Convert.NewArray == 0);
+                AX_CHECK(Build.New == 0 && Build.NewArray == 1);
+            }
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testChain(void)
+{
+    TString Str("Hello, World! [@`{]");
+
+    AX_CHECK(ToStd(Str.ToUpperCase()) == "HELLO, WORLD! [@`{]");
+    AX_CHECK(ToStd(Str.ToLowerCase()) == "hello, world! [@`{]");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRandom();
+    _testChain();
+    if (std::setlocale(LC_CTYPE, "C.UTF-8"))
+        _testRandom();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Pragma once
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "String.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Fails the test with the location of the check when `Cond` does
+/// not hold. Unlike `assert`, it stays on in release builds.
+///
+///////////////////////////////////////////////////////////////////////////////
+#define AX_CHECK(Cond)                                                        \
+    do                                                                        \
+    {                                                                         \
+        if (!(Cond))                                                          \
+        {                                                                     \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__,      \
+                __LINE__, #Cond);                                             \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Builds a string from bytes that may hold NULs.
+///
+///////////////////////////////////////////////////////////////////////////////
+inline Ax::TString MakeString(const std::string& Bytes)
+{
+    Ax::TString Str;
+
+    if (!Bytes.empty())
+        Str.Append(Bytes.data(), Bytes.size());
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Copies the bytes of a string, NULs included.
+///
+///////////////////////////////////////////////////////////////////////////////
+inline std::string ToStd(const Ax::TString& Str)
+{
+    return (Str.Length() ? std::string(Str.CStr(), Str.Length())
+        : std::string());
+}
@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include <random>
+#include <set>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Few distinct bytes, NUL and 0xFF included, so that long common prefixes,
+/// embedded NULs and signedness all matter.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomBytes(std::mt19937& Rng, size_t Len)
+{
+    static const char Bytes[] = {'a', 'b', '\0', '\xFF', '\x7F', '\x80'};
+    std::string Str;
+
+    for (size_t i = 0; i < Len; ++i)
+        Str += Bytes[Rng() % (Rng() % 8 ? 2 : 6)];
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _checkPair(const std::string& A, const std::string& B)
+{
+    const TString TA = MakeString(A);
+    const TString TB = MakeString(B);
+
+    AX_CHECK((TA == TB) == (A == B));
+    AX_CHECK((TA != TB) == (A != B));
+    AX_CHECK((TA < TB) == (A < B));
+    AX_CHECK((TA > TB) == (A > B));
+    AX_CHECK((TA <= TB) == (A <= B));
+    AX_CHECK((TA >= TB) == (A >= B));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(34);
+
+    for (int Round = 0; Round < 100000; ++Round)
+    {
+        const std::string A = _randomBytes(Rng, Rng() % 40);
+        std::string B = _randomBytes(Rng, Rng() % 40);
+
+        // Often share a prefix, or be a prefix, of the other side.
+        if (Round % 3 == 0)
+            B = A.substr(0, Rng() % (A.size() + 1)) + B.substr(0, Rng() % 3);
+        _checkPair(A, B);
+        _checkPair(B, A);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Ordered containers must sort TString as std::string sorts bytes.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testOrder(void)
+{
+    std::mt19937 Rng(35);
+    std::set<std::string> Expected;
+    std::set<TString> Strings;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        const std::string Str = _randomBytes(Rng, Rng() % 12);
+
+        Expected.insert(Str);
+        Strings.insert(MakeString(Str));
+    }
+    AX_CHECK(Strings.size() == Expected.size());
+
+    auto It = Expected.begin();
+    for (const TString& Str : Strings)
+        AX_CHECK(ToStd(Str) == *It++);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testEdges(void)
+{
+    const TString Str("abc");
+    TString Nul;
+
+    Nul.Append("ab\0d", 4);
+    AX_CHECK(Str == Str && !(Str < Str) && Str <= Str);
+    AX_CHECK(TString() == TString() && TString() < Str);
+    AX_CHECK(TString("ab") < Str && TString("b") > Str);
+    AX_CHECK(Nul != TString("ab") && Nul > TString("ab") && Nul < Str);
+    AX_CHECK(MakeString("\xFF") > MakeString("a"));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRandom();
+    _testOrder();
+    _testEdges();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Pragma once
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+///////////////////////////////////////////////////////////////////////////////
+/// Replaces the global operator new and new[] to count their calls, so
+/// tests can check how many allocations an operation makes. Include it in
+/// a single translation unit of the test program.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::atomic<size_t> _newCalls{0};
+static std::atomic<size_t> _newArrayCalls{0};
+
+///////////////////////////////////////////////////////////////////////////////
+static void* _allocate(size_t Size)
+{
+    void* Ptr = std::malloc(Size ? Size : 1);
+
+    if (!Ptr)
+        throw std::bad_alloc();
+    return (Ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void* operator new(size_t Size)
+{
+    _newCalls.fetch_add(1, std::memory_order_relaxed);
+    return (_allocate(Size));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void* operator new[](size_t Size)
+{
+    _newArrayCalls.fetch_add(1, std::memory_order_relaxed);
+    return (_allocate(Size));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void operator delete(void* Ptr) noexcept
+{
+    std::free(Ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void operator delete[](void* Ptr) noexcept
+{
+    std::free(Ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void operator delete(void* Ptr, size_t) noexcept
+{
+    std::free(Ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void operator delete[](void* Ptr, size_t) noexcept
+{
+    std::free(Ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Counts the calls to operator new and new[] made by a function.
+///
+///////////////////////////////////////////////////////////////////////////////
+struct TAllocations
+{
+    size_t New;         //<! Calls to operator new.
+    size_t NewArray;    //<! Calls to operator new[].
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename F>
+TAllocations CountAllocations(F Func)
+{
+    const size_t New = _newCalls.load();
+    const size_t NewArray = _newArrayCalls.load();
+
+    Func();
+    return (TAllocations{_newCalls.load() - New,
+        _newArrayCalls.load() - NewArray});
+}
@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+static const size_t _none = static_cast<size_t>(-1);
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomText(std::mt19937& Rng, size_t Len)
+{
+    std::string Str;
+
+    for (size_t i = 0; i < Len; ++i)
+        Str += static_cast<char>('a' + Rng() % 3);
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Classic dynamic programming. With `Search`, the first row is all zeros
+/// so that a match may start anywhere, and the last row is returned.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::vector<size_t> _lastRow(const std::string& Needle,
+    const std::string& Text, bool Search)
+{
+    std::vector<size_t> Row(Text.size() + 1);
+
+    for (size_t j = 0; j <= Text.size(); ++j)
+        Row[j] = Search ? 0 : j;
+    for (size_t i = 1; i <= Needle.size(); ++i)
+    {
+        size_t Diagonal = Row[0];
+
+        Row[0] = i;
+        for (size_t j = 1; j <= Text.size(); ++j)
+        {
+            const size_t Up = Row[j];
+
+            Row[j] = std::min({Up + 1, Row[j - 1] + 1,
+                Diagonal + (Needle[i - 1] != Text[j - 1])});
+            Diagonal = Up;
+        }
+    }
+    return (Row);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static size_t _distance(const std::string& A, const std::string& B)
+{
+    return (_lastRow(A, B, false).back());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Whole-string distances, bounded or not, with strings long enough to
+/// span several 64-row blocks.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testDistance(void)
+{
+    std::mt19937 Rng(31);
+
+    for (int Round = 0; Round < 300; ++Round)
+    {
+        const std::string Query = _randomText(Rng, Rng() % 200);
+        std::vector<std::string> Others;
+        std::vector<TString> Candidates;
+
+        for (int i = 0; i < 8; ++i)
+        {
+            std::string Other = _randomText(Rng, Rng() % 200);
+
+            if (i % 2 && !Query.empty())
+            {
+                Other = Query;
+                for (unsigned Edit = Rng() % 10; Edit > 0; --Edit)
+                    Other[Rng() % Other.size()] = 'c';
+            }
+            Others.push_back(Other);
+            Candidates.push_back(MakeString(Other));
+        }
+
+        const TString TQuery = MakeString(Query);
+        const size_t K = Rng() % 40;
+        const std::vector<size_t> All =
+            TString::BatchEditDistance(TQuery, Candidates);
+        const std::vector<size_t> Bounded =
+            TString::BatchEditDistance(TQuery, Candidates, K);
+
+        for (size_t i = 0; i < Others.size(); ++i)
+        {
+            const size_t Expected = _distance(Query, Others[i]);
+            const size_t Capped = Expected <= K ? Expected : _none;
+
+            AX_CHECK(TQuery.EditDistance(Candidates[i]) == Expected);
+            AX_CHECK(Candidates[i].EditDistance(TQuery) == Expected);
+            AX_CHECK(TQuery.BoundedEditDistance(Candidates[i], K) == Capped);
+            AX_CHECK(All[i] == Expected);
+            AX_CHECK(Bounded[i] == Capped);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// FindApprox must stop at the first end position within `K` errors,
+/// pushed right while the error count falls, and report a start whose
+/// substring is exactly that far from the needle.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testFindApprox(void)
+{
+    std::mt19937 Rng(32);
+
+    for (int Round = 0; Round < 3000; ++Round)
+    {
+        const std::string Text = _randomText(Rng, Rng() % 300);
+        std::string Needle = _randomText(Rng, 1 + Rng() % 90);
+
+        if (Rng() % 2 && Text.size() > 1)
+        {
+            const size_t At = Rng() % Text.size();
+
+            Needle = Text.substr(At, 1 + Rng() % 90);
+            for (unsigned Edit = Rng() % 4; Edit > 0; --Edit)
+                Needle[Rng() % Needle.size()] = 'c';
+        }
+
+        const size_t K = Rng() % (Needle.size() + 2) / 2;
+        const size_t Pos = Rng() % (Text.size() + 1);
+        const std::vector<size_t> Row =
+            _lastRow(Needle, Text.substr(Pos), true);
+        size_t End = _none;
+
+        for (size_t j = 0; j < Row.size(); ++j)
+        {
+            if (Row[j] <= K)
+            {
+                End = j;
+                break;
+            }
+        }
+        while (End != _none && End + 1 < Row.size() && Row[End + 1] < Row[End])
+            ++End;
+
+        size_t Len = _none;
+        const size_t Found = MakeString(Text).FindApprox(MakeString(Needle),
+            K, Pos, &Len);
+
+        if (End == _none)
+        {
+            AX_CHECK(Found == _none);
+            continue;
+        }
+        AX_CHECK(Found != _none && Found + Len == Pos + End);
+        AX_CHECK(Found >= Pos);
+        AX_CHECK(_distance(Needle, Text.substr(Found, Len)) == Row[End]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testEdges(void)
+{
+    size_t Len = 1;
+
+    AX_CHECK(TString("kitten").EditDistance(TString("sitting")) == 3);
+    AX_CHECK(TString().EditDistance(TString("abc")) == 3);
+    AX_CHECK(TString("abc").BoundedEditDistance(TString(), 2) == _none);
+    AX_CHECK(TString("abcdef").FindApprox(TString("xy"), 2, 3, &Len) == 3);
+    AX_CHECK(Len == 0);
+    AX_CHECK(TString("abc").FindApprox(TString("abc"), 0, 4) == _none);
+    AX_CHECK(TString("the quick brown fox").FindApprox(TString("quack"), 1,
+        0, &Len) == 4);
+    AX_CHECK(Len == 5);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testDistance();
+    _testFindApprox();
+    _testEdges();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Mostly 'a' with a few 'b', so that needles match often and partial
+/// matches are common; high bytes check the unsigned comparisons.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomText(std::mt19937& Rng, size_t Len)
+{
+    std::string Str;
+
+    for (size_t i = 0; i < Len; ++i)
+    {
+        const unsigned Pick = Rng() % 16;
+
+        Str += Pick < 12 ? 'a' : Pick < 15 ? 'b' : '\xE9';
+    }
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static std::vector<size_t> _findAll(const std::string& Hay,
+    const std::string& Needle, size_t Pos)
+{
+    std::vector<size_t> Found;
+
+    if (Needle.empty())
+        return (Found);
+    for (size_t At = Hay.find(Needle, Pos); At != std::string::npos;
+        At = Hay.find(Needle, At + Needle.size()))
+        Found.push_back(At);
+    return (Found);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static std::vector<size_t> _findAll(const std::string& Hay, char Ch,
+    size_t Pos)
+{
+    std::vector<size_t> Found;
+
+    for (size_t i = Pos; i < Hay.size(); ++i)
+    {
+        if (Hay[i] == Ch)
+            Found.push_back(i);
+    }
+    return (Found);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(27);
+
+    for (int Round = 0; Round < 20000; ++Round)
+    {
+        const size_t Len = Round % 100 == 0 ? 5000 + Rng() % 100 : Rng() % 200;
+        const std::string Hay = _randomText(Rng, Len);
+        std::string Needle = _randomText(Rng, 1 + Rng() % 40);
+
+        if (Rng() % 2 && !Hay.empty())
+            Needle = Hay.substr(Rng() % Hay.size(), 1 + Rng() % 40);
+
+        const size_t Pos = Rng() % (Hay.size() + 3);
+        const TString Str = MakeString(Hay);
+        const TString Sub = MakeString(Needle);
+        const std::vector<size_t> Expected = _findAll(Hay, Needle, Pos);
+
+        AX_CHECK(Str.Find(Sub, Pos) == Hay.find(Needle, Pos));
+        AX_CHECK(Str.Find(Needle.c_str(), Pos) == Hay.find(Needle, Pos));
+        AX_CHECK(Str.FindAll(Sub, Pos) == Expected);
+        AX_CHECK(Str.FindAll(Needle.c_str(), Pos) == Expected);
+        AX_CHECK(Str.Count(Sub, Pos) == Expected.size());
+        AX_CHECK(Str.Count(Needle.c_str(), Pos) == Expected.size());
+
+        const char Ch = Needle[0];
+        const std::vector<size_t> Chars = _findAll(Hay, Ch, Pos);
+
+        AX_CHECK(Str.Find(Ch, Pos) == Hay.find(Ch, Pos));
+        AX_CHECK(Str.FindAll(Ch, Pos) == Chars);
+        AX_CHECK(Str.Count(Ch, Pos) == Chars.size());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testEdges(void)
+{
+    const TString Str("aaaaa");
+
+    AX_CHECK(Str.FindAll(TString("aa")) == (std::vector<size_t>{0, 2}));
+    AX_CHECK(Str.Count(TString("aa")) == 2);
+    AX_CHECK(Str.FindAll(TString()).empty());
+    AX_CHECK(Str.Count("") == 0);
+    AX_CHECK(TString().FindAll('a').empty());
+    AX_CHECK(TString().Count(TString("a")) == 0);
+    AX_CHECK(Str.Count('a', 5) == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRandom();
+    _testEdges();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testIntegers(void)
+{
+    std::mt19937_64 Rng(50);
+    char Buffer[32];
+
+    AX_CHECK(ToStd(TString().AppendInt(0)) == "0");
+    AX_CHECK(ToStd(TString().AppendInt(INT64_MIN)) == "-9223372036854775808");
+    AX_CHECK(ToStd(TString().AppendInt(INT64_MAX)) == "9223372036854775807");
+    AX_CHECK(ToStd(TString().AppendUInt(UINT64_MAX))
+        == "18446744073709551615");
+    for (int i = 0; i < 10000; ++i)
+    {
+        const uint64_t Bits = Rng() >> (Rng() % 64);
+        const int64_t Signed = static_cast<int64_t>(Bits) * (i & 1 ? -1 : 1);
+
+        std::snprintf(Buffer, sizeof(Buffer), "%llu",
+            static_cast<unsigned long long>(Bits));
+        AX_CHECK(ToStd(TString().AppendUInt(Bits)) == Buffer);
+        std::snprintf(Buffer, sizeof(Buffer), "%lld",
+            static_cast<long long>(Signed));
+        AX_CHECK(ToStd(TString().AppendInt(Signed)) == Buffer);
+    }
+
+    TString Str("n=");
+    Str.AppendInt(-5).Append(",").AppendUInt(7);
+    AX_CHECK(ToStd(Str) == "n=-5,7");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Shortest form must read back to the same value.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testFloating(void)
+{
+    std::mt19937_64 Rng(51);
+
+    AX_CHECK(ToStd(TString().AppendDouble(0.1)) == "0.1");
+    AX_CHECK(ToStd(TString().AppendDouble(-2.5)) == "-2.5");
+    AX_CHECK(ToStd(TString().AppendDouble(1e300)) == "1e+300");
+    AX_CHECK(ToStd(TString().AppendFloat(0.1f)) == "0.1");
+    for (int i = 0; i < 10000; ++i)
+    {
+        const uint64_t Bits = Rng();
+        double Value;
+
+        std::memcpy(&Value, &Bits, sizeof(Value));
+        if (!std::isfinite(Value))
+            continue;
+
+        const TString Str = TString().AppendDouble(Value);
+
+        AX_CHECK(std::strtod(ToStd(Str).c_str(), nullptr) == Value);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testFrom(void)
+{
+    AX_CHECK(ToStd(TString::From(42)) == "42");
+    AX_CHECK(ToStd(TString::From(-42L)) == "-42");
+    AX_CHECK(ToStd(TString::From(42u)) == "42");
+    AX_CHECK(ToStd(TString::From(static_cast<short>(-3))) == "-3");
+    AX_CHECK(ToStd(TString::From(1.5)) == "1.5");
+    AX_CHECK(ToStd(TString::From(0.1f)) == "0.1");
+    AX_CHECK(ToStd(TString::From(static_cast<long double>(0.25))) == "0.25");
+    AX_CHECK(ToStd(TString::From('A')) == "A");
+    AX_CHECK(ToStd(TString::From('\0')) == std::string(1, '\0'));
+    AX_CHECK(ToStd(TString::From(true)) == "true");
+    AX_CHECK(ToStd(TString::From(false)) == "false");
+    AX_CHECK(ToStd(TString::From(static_cast<int8_t>(-65))) == "-65");
+    AX_CHECK(ToStd(TString::From(static_cast<uint8_t>(200))) == "200");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testIntegers();
+    _testFloating();
+    _testFrom();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "FrontCodedTable.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TFrontCodedTable;
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomKey(std::mt19937& Rng, size_t MaxLen)
+{
+    static const char Bytes[] = {'a', 'b', '\0', '\xFF'};
+    std::string Str;
+
+    for (size_t i = 0, n = Rng() % (MaxLen + 1); i < n; ++i)
+        Str += Bytes[Rng() % 4];
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _checkTable(std::mt19937& Rng, const TFrontCodedTable& Table,
+    const std::vector<std::string>& Keys)
+{
+    AX_CHECK(Table.Size() == Keys.size());
+    for (size_t i = 0; i < Keys.size(); ++i)
+        AX_CHECK(ToStd(Table.Get(i)) == Keys[i]);
+
+    const size_t First = Rng() % (Keys.size() + 1);
+    const size_t Last = First + Rng() % (Keys.size() - First + 1);
+    const std::vector<TString> Range = Table.GetRange(First, Last);
+
+    AX_CHECK(Range.size() == Last - First);
+    for (size_t i = 0; i < Range.size(); ++i)
+        AX_CHECK(ToStd(Range[i]) == Keys[First + i]);
+    for (int Query = 0; Query < 30; ++Query)
+    {
+        const std::string Key = _randomKey(Rng, 8);
+        const size_t Lower = std::lower_bound(Keys.begin(), Keys.end(), Key)
+            - Keys.begin();
+        size_t End = Lower;
+
+        while (End < Keys.size() && Keys[End].compare(0, Key.size(), Key) == 0)
+            ++End;
+        AX_CHECK(Table.LowerBound(MakeString(Key)) == Lower);
+
+        const auto Prefix = Table.PrefixRange(MakeString(Key));
+
+        AX_CHECK(Prefix.first == Lower && Prefix.second == End);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Sorted keys with duplicates and long shared prefixes, for several
+/// restart intervals, and the same table read back from its buffer.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(39);
+
+    for (int Round = 0; Round < 300; ++Round)
+    {
+        std::vector<std::string> Keys(Rng() % 300);
+
+        for (std::string& Key : Keys)
+            Key = _randomKey(Rng, 12);
+        std::sort(Keys.begin(), Keys.end());
+
+        std::vector<TString> Sorted;
+
+        for (const std::string& Key : Keys)
+            Sorted.push_back(MakeString(Key));
+
+        const size_t Intervals[] = {1, 2, 3, 16, 100};
+        TFrontCodedTable Table;
+        TFrontCodedTable Loaded;
+
+        AX_CHECK(Table.Build(Sorted, Intervals[Round % 5]));
+        _checkTable(Rng, Table, Keys);
+        AX_CHECK(Loaded.FromBuffer(Table.Buffer()));
+        AX_CHECK(Loaded.Buffer() == Table.Buffer());
+        _checkTable(Rng, Loaded, Keys);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Unsorted input, a zero interval and damaged buffers are rejected and
+/// leave the table as it was; a damaged buffer that still parses must be
+/// fully readable.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testInvalid(void)
+{
+    std::mt19937 Rng(40);
+    const std::vector<TString> Sorted = {TString("apple"), TString("apply"),
+        TString("banana"), TString("band"), TString("bandana")};
+    TFrontCodedTable Table;
+
+    AX_CHECK(Table.Build(Sorted, 2));
+    AX_CHECK(!Table.Build({TString("b"), TString("a")}));
+    AX_CHECK(!Table.Build(Sorted, 0));
+    AX_CHECK(Table.Size() == 5 && ToStd(Table.Get(3)) == "band");
+    AX_CHECK(Table.PrefixRange(TString("ban"))
+        == std::make_pair(size_t(2), size_t(5)));
+
+    const std::vector<char> Good = Table.Buffer();
+
+    for (size_t Len = 0; Len < Good.size(); ++Len)
+    {
+        AX_CHECK(!Table.FromBuffer(std::vector<char>(Good.begin(),
+            Good.begin() + Len)));
+        AX_CHECK(Table.Buffer() == Good);
+    }
+    for (int Round = 0; Round < 20000; ++Round)
+    {
+        std::vector<char> Bad = Good;
+        TFrontCodedTable Other;
+
+        Bad[Rng() % Bad.size()] ^= static_cast<char>(1 + Rng() % 255);
+        if (!Other.FromBuffer(Bad))
+            continue;
+        for (size_t i = 0; i < Other.Size(); ++i)
+            Other.Get(i);
+        Other.LowerBound(TString("band"));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRandom();
+    _testInvalid();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,217 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "Glob.hpp"
+#include <fnmatch.h>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TGlob;
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+static const char _alphabet[] = "ab-]![\\^*?";
+
+///////////////////////////////////////////////////////////////////////////////
+/// One pattern element: a literal, escaped when it is special, a star, a
+/// question mark, or a well-formed set that may start with ']', hold
+/// ranges, escapes and a '['.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomToken(std::mt19937& Rng)
+{
+    const unsigned Kind = Rng() % 10;
+    std::string Token;
+
+    if (Kind < 4)
+    {
+        const char Ch = _alphabet[Rng() % (sizeof(_alphabet) - 1)];
+
+        if (Ch == '*' || Ch == '?' || Ch == '[' || Ch == '\\'
+            || (Ch == ']' && Rng() % 2))
+            Token += '\\';
+        return (Token += Ch);
+    }
+    if (Kind < 6)
+        return ("*");
+    if (Kind < 8)
+        return ("?");
+    Token = "[";
+    if (Rng() % 3 == 0)
+        Token += Rng() % 2 ? '!' : '^';
+    if (Rng() % 4 == 0)
+        Token += ']';
+    for (unsigned i = 0, n = 1 + Rng() % 3; i < n; ++i)
+    {
+        const char Ch = "ab-!^[\\"[Rng() % 7];
+
+        Token += Ch;
+        if (Ch == '\\')
+            Token += _alphabet[Rng() % (sizeof(_alphabet) - 1)];
+        if (Rng() % 4 == 0)
+            Token += Rng() % 2 ? "-a" : "-b";
+    }
+    return (Token += ']');
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomSubject(std::mt19937& Rng, size_t Len)
+{
+    std::string Str;
+
+    for (size_t i = 0; i < Len; ++i)
+        Str += _alphabet[Rng() % (sizeof(_alphabet) - 1)];
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Short patterns and subjects over the special characters, against
+/// fnmatch with no flags.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testFnmatch(void)
+{
+    std::mt19937 Rng(30);
+
+    for (int i = 0; i < 200000; ++i)
+    {
+        std::string Pattern;
+
+        for (unsigned j = 0, n = Rng() % 5; j < n; ++j)
+            Pattern += _randomToken(Rng);
+
+        const std::string Subject = _randomSubject(Rng, Rng() % 8);
+        const TGlob Glob(TString(Pattern.c_str()));
+
+        AX_CHECK(Glob.Match(TString(Subject.c_str()))
+            == (fnmatch(Pattern.c_str(), Subject.c_str(), 0) == 0));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Long subjects and segments of more than 64 elements, which take the
+/// `TString::Find` and wide Shift-And paths.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testLong(void)
+{
+    std::mt19937 Rng(31);
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        const std::string Subject = _randomSubject(Rng, Rng() % 400);
+        std::string Pattern;
+
+        for (unsigned Star = 0, n = Rng() % 3; Star <= n; ++Star)
+        {
+            if (Star)
+                Pattern += '*';
+            if (!Subject.empty() && Rng() % 2)
+            {
+                const size_t At = Rng() % Subject.size();
+                const std::string Piece = Subject.substr(At, Rng() % 100);
+
+                for (char Ch : Piece)
+                {
+                    if (Rng() % 8 == 0)
+                        Pattern += '?';
+                    else if (Ch == '*' || Ch == '?' || Ch == '['
+                        || Ch == '\\')
+                        Pattern += std::string("\\") + Ch;
+                    else
+                        Pattern += Ch;
+                }
+            }
+            else
+                Pattern += _randomToken(Rng);
+        }
+
+        const TGlob Glob(TString(Pattern.c_str()));
+
+        AX_CHECK(Glob.Match(TString(Subject.c_str()))
+            == (fnmatch(Pattern.c_str(), Subject.c_str(), 0) == 0));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testMany(void)
+{
+    std::mt19937 Rng(32);
+    std::vector<TGlob> Globs;
+
+    for (int i = 0; i < 64; ++i)
+    {
+        std::string Pattern;
+
+        for (unsigned j = 0, n = Rng() % 4; j < n; ++j)
+            Pattern += _randomToken(Rng);
+        Globs.emplace_back(TString(Pattern.c_str()));
+    }
+    for (int i = 0; i < 5000; ++i)
+    {
+        const TString Subject(_randomSubject(Rng, Rng() % 6).c_str());
+        std::vector<size_t> Expected;
+
+        for (size_t j = 0; j < Globs.size(); ++j)
+        {
+            if (Globs[j].Match(Subject))
+                Expected.push_back(j);
+        }
+        AX_CHECK(TGlob::MatchAll(Subject, Globs) == Expected);
+        AX_CHECK(TGlob::MatchFirst(Subject, Globs)
+            == (Expected.empty() ? size_t(TGlob::npos) : Expected[0]));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Where fnmatch reports an error, TGlob takes the character literally.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testLiteral(void)
+{
+    AX_CHECK(TGlob(TString("a\\")).Match(TString("a\\")));
+    AX_CHECK(TGlob(TString("[a")).Match(TString("[a")));
+    AX_CHECK(!TGlob(TString("[a")).Match(TString("a")));
+    AX_CHECK(TGlob(TString("*[*")).Match(TString("x[yz")));
+    AX_CHECK(TGlob().Match(TString()));
+    AX_CHECK(!TGlob().Match(TString("a")));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testFnmatch();
+    _testLong();
+    _testMany();
+    _testLiteral();
+    std::puts("ok");
+    return (0);
+}
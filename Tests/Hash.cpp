@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include <bitset>
+#include <cstring>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+/// The test vectors of the wyhash reference (final version 4): message `i`
+/// hashed with seed `i`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testVectors(void)
+{
+    static const char* Messages[] = {"", "a", "abc", "message digest",
+        "abcdefghijklmnopqrstuvwxyz",
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+        "1234567890123456789012345678901234567890"
+        "1234567890123456789012345678901234567890"};
+    static const uint64_t Expected[] = {0x0409638ee2bde459ull,
+        0xa8412d091b5fe0a9ull, 0x32dd92e4b2915153ull, 0x8619124089a3a16bull,
+        0x7a43afb61d7f5f40ull, 0xff42329b90e50d58ull, 0xc39cab13b115aad3ull};
+
+    for (uint64_t i = 0; i < 7; ++i)
+    {
+        const size_t Len = std::strlen(Messages[i]);
+
+        AX_CHECK(TString::HashBytes(Messages[i], Len, i) == Expected[i]);
+        AX_CHECK(MakeString(std::string(Messages[i], Len)).Hash(i)
+            == Expected[i]);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Every entry point agrees, whatever the alignment of the bytes.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testConsistency(void)
+{
+    std::mt19937_64 Rng(35);
+    char Buffer[256 + 8];
+
+    for (size_t Len = 0; Len < 256; ++Len)
+    {
+        std::string Bytes;
+
+        for (size_t i = 0; i < Len; ++i)
+            Bytes += static_cast<char>(Rng());
+
+        const TString Str = MakeString(Bytes);
+        const uint64_t Seed = Rng();
+
+        AX_CHECK(std::hash<TString>()(Str)
+            == static_cast<size_t>(TString::HashBytes(Bytes.data(), Len)));
+        AX_CHECK(Str.Hash(Seed)
+            == TString::HashBytes(Bytes.data(), Len, Seed));
+        AX_CHECK(TString::SeededHasher(Seed)(Str) == Str.Hash(Seed));
+        AX_CHECK(TString::SeededHasher()(Str)
+            == TString::SeededHasher()(MakeString(Bytes)));
+        for (size_t Offset = 1; Offset < 8; ++Offset)
+        {
+            std::memcpy(Buffer + Offset, Bytes.data(), Len);
+            AX_CHECK(TString::HashBytes(Buffer + Offset, Len, Seed)
+                == Str.Hash(Seed));
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// No collision among close keys, and a one-bit change in the input or
+/// the seed flips about half of the output bits.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testQuality(void)
+{
+    std::unordered_set<uint64_t> Seen;
+    std::mt19937_64 Rng(36);
+    size_t Flipped = 0;
+    size_t Trials = 0;
+
+    for (int i = 0; i < 200000; ++i)
+    {
+        const std::string Key = "key-" + std::to_string(i);
+
+        AX_CHECK(Seen.insert(TString::HashBytes(Key.data(),
+            Key.size())).second);
+    }
+    for (size_t Len = 1; Len < 100; ++Len)
+    {
+        std::string Bytes(Len, '\0');
+
+        for (char& Ch : Bytes)
+            Ch = static_cast<char>(Rng());
+
+        const uint64_t Base = TString::HashBytes(Bytes.data(), Len, 7);
+
+        for (size_t Bit = 0; Bit < Len * 8; Bit += 3)
+        {
+            Bytes[Bit / 8] ^= static_cast<char>(1 << (Bit % 8));
+            Flipped += std::bitset<64>(Base
+                ^ TString::HashBytes(Bytes.data(), Len, 7)).count();
+            Bytes[Bit / 8] ^= static_cast<char>(1 << (Bit % 8));
+            ++Trials;
+        }
+        Flipped += std::bitset<64>(Base
+            ^ TString::HashBytes(Bytes.data(), Len, 7 ^ 1)).count();
+        ++Trials;
+    }
+    AX_CHECK(Flipped > Trials * 30 && Flipped < Trials * 34);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testVectors();
+    _testConsistency();
+    _testQuality();
+    std::puts("ok");
+    return (0);
+}
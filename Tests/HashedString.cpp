@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "HashedString.hpp"
+#include "StringMap.hpp"
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::THashedString;
+using Ax::TString;
+using Ax::TStringMap;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Checks the kept hash against a fresh one.
+///
+///////////////////////////////////////////////////////////////////////////////
+static bool _fresh(const THashedString& Str)
+{
+    return (Str.Hash() == Str.Str().Hash(Str.Seed()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// The hash no longer lives in TString, so writing through a reference taken
+/// before hashing cannot leave a stale value behind.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testString(void)
+{
+    AX_CHECK(sizeof(TString) == sizeof(char*) + 3 * sizeof(size_t));
+
+    TString Str("abc");
+    char& First = Str[0];
+    const uint64_t Before = Str.Hash();
+
+    First = 'x';
+    AX_CHECK(Str.Hash() != Before);
+    AX_CHECK(Str == TString("xbc"));
+    AX_CHECK(Str.Hash() == TString("xbc").Hash());
+
+    TStringMap<int> Map;
+
+    Map.Insert(TString("xbc"), 1);
+    AX_CHECK(Map.Find(Str) != nullptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testMutators(void)
+{
+    THashedString Str("hello", 7);
+
+    AX_CHECK(Str.Seed() == 7 && _fresh(Str));
+    Str.Append(TString(", world"));
+    AX_CHECK(ToStd(Str.Str()) == "hello, world" && _fresh(Str));
+    Str.Append("!?", 1);
+    AX_CHECK(ToStd(Str.Str()) == "hello, world!" && _fresh(Str));
+    Str.Modify([](TString& Content) { Content[0] = 'j'; });
+    AX_CHECK(ToStd(Str.Str()) == "jello, world!" && _fresh(Str));
+    Str.Assign(TString("abc"));
+    AX_CHECK(Str.Length() == 3 && _fresh(Str));
+
+    TString Moved("moved");
+    Str.Assign(std::move(Moved));
+    AX_CHECK(ToStd(Str.Str()) == "moved" && _fresh(Str));
+
+    TString Out = Str.Release();
+    AX_CHECK(ToStd(Out) == "moved");
+    AX_CHECK(Str.Length() == 0 && _fresh(Str));
+    Str.Append(Out);
+    Str.Clear();
+    AX_CHECK(Str.Length() == 0 && _fresh(Str));
+    AX_CHECK(_fresh(THashedString()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testEquality(void)
+{
+    const THashedString A("key", 1);
+    const THashedString B(TString("key"), 1);
+    const THashedString C("key", 2);
+    const THashedString D("kez", 1);
+
+    AX_CHECK(A == B && !(A != B));
+    AX_CHECK(A == C);
+    AX_CHECK(A != D && C != D);
+
+    std::hash<THashedString> Hasher;
+    std::unordered_set<THashedString> Set;
+
+    AX_CHECK(Hasher(A) == Hasher(C));
+    AX_CHECK(Hasher(A) == std::hash<TString>()(TString("key")));
+    Set.insert(A);
+    AX_CHECK(Set.count(C) == 1 && Set.count(D) == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testMap(void)
+{
+    TStringMap<int> Map;
+
+    for (int i = 0; i < 1000; ++i)
+        Map.Insert(THashedString(TString::From(i), Map.Seed()), i);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const TString Key = TString::From(i);
+        const int* Value = Map.Find(THashedString(Key, Map.Seed()));
+
+        AX_CHECK(Value && *Value == i);
+        Value = Map.Find(THashedString(Key, Map.Seed() + 1));
+        AX_CHECK(Value && *Value == i);
+        AX_CHECK(Map.Find(Key) && *Map.Find(Key) == i);
+    }
+    AX_CHECK(!Map.Contains(THashedString("missing", Map.Seed())));
+    AX_CHECK(Map.Erase(THashedString("7", Map.Seed())));
+    AX_CHECK(!Map.Contains("7"));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Shared strings and a shared map are only read, from several threads at
+/// once; run under -fsanitize=thread this must report nothing.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testThreads(void)
+{
+    TStringMap<int> Map;
+    std::vector<THashedString> Keys;
+    std::atomic<int> Failures{0};
+    std::vector<std::thread> Threads;
+
+    for (int i = 0; i < 256; ++i)
+    {
+        Keys.emplace_back(TString::From(i), Map.Seed());
+        Map.Insert(Keys.back(), i);
+    }
+
+    const TStringMap<int>& Shared = Map;
+
+    for (int t = 0; t < 4; ++t)
+    {
+        Threads.emplace_back([&, t]()
+        {
+            for (int Round = 0; Round < 50; ++Round)
+            {
+                for (size_t i = 0; i < Keys.size(); ++i)
+                {
+                    const THashedString& Key = Keys[(i + t) % Keys.size()];
+                    const int* Value = Shared.Find(Key);
+
+                    if (!Value || !(Keys[*Value] == Key) || !_fresh(Key)
+                        || Key.Str().Hash(Key.Seed()) != Key.Hash())
+                        Failures.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (std::thread& Thread : Threads)
+        Thread.join();
+    AX_CHECK(Failures.load() == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testString();
+    _testMutators();
+    _testEquality();
+    _testMap();
+    _testThreads();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "CountNew.hpp"
+#include <cctype>
+#include <random>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+static const size_t _none = static_cast<size_t>(-1);
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _reference(const std::string& Bytes, bool Upper)
+{
+    const char* Digits = Upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::string Hex;
+
+    for (char Ch : Bytes)
+    {
+        const unsigned char Byte = static_cast<unsigned char>(Ch);
+
+        Hex += Digits[Byte >> 4];
+        Hex += Digits[Byte & 15];
+    }
+    return (Hex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Every length across several vector steps, both cases, and decoding of
+/// mixed-case digits back to the bytes.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRoundTrip(void)
+{
+    std::mt19937 Rng(45);
+
+    for (size_t Len = 0; Len < 200; ++Len)
+    {
+        std::string Bytes;
+
+        for (size_t i = 0; i < Len; ++i)
+            Bytes += static_cast<char>(Rng());
+
+        const TString Str = MakeString(Bytes);
+
+        for (bool Upper : {false, true})
+        {
+            TString Hex;
+            const TAllocations Made = CountAllocations([&]()
+            {
+                Hex = Str.ToHex(Upper);
+            });
+
+            AX_CHECK(ToStd(Hex) == _reference(Bytes, Upper));
+            AX_CHECK(Made.NewArray == 1);
+            AX_CHECK(ToStd(TString("x").AppendHex(Bytes.data(), Len, Upper))
+                == "x" + _reference(Bytes, Upper));
+        }
+
+        std::string Mixed = _reference(Bytes, false);
+
+        for (char& Ch : Mixed)
+            Ch = Rng() % 2 ? static_cast<char>(std::toupper(Ch)) : Ch;
+
+        TString Out("old");
+        size_t Offset = 0;
+
+        AX_CHECK(TString::FromHex(Mixed.data(), Mixed.size(), Out, &Offset));
+        AX_CHECK(ToStd(Out) == Bytes && Offset == _none);
+
+        TString Appended("x");
+        AX_CHECK(Appended.AppendFromHex(Mixed.data(), Mixed.size()));
+        AX_CHECK(ToStd(Appended) == "x" + Bytes);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// One bad digit anywhere, or an odd length, is reported at the right
+/// offset and leaves the output untouched.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testInvalid(void)
+{
+    std::mt19937 Rng(46);
+    static const char Bad[] = {'g', 'G', '/', ':', '@', '`', ' ', '\0',
+        '\xFF'};
+
+    for (int Round = 0; Round < 20000; ++Round)
+    {
+        std::string Hex = _reference(std::string(Rng() % 100, 'x'), false);
+        size_t Expected = _none;
+
+        for (char& Ch : Hex)
+            Ch = "0123456789abcdefABCDEF"[Rng() % 22];
+        if (Rng() % 3)
+        {
+            Hex += "0";
+            Expected = Hex.size() - 1;
+        }
+        if (!Hex.empty() && Rng() % 2)
+        {
+            const size_t At = Rng() % Hex.size();
+
+            Hex[At] = Bad[Rng() % 9];
+            Expected = std::min(Expected, At);
+        }
+
+        TString Out("kept");
+        TString Appended("kept");
+        size_t Offset = 0;
+        const bool Valid = Expected == _none;
+
+        AX_CHECK(TString::FromHex(Hex.data(), Hex.size(), Out, &Offset)
+            == Valid);
+        AX_CHECK(Offset == Expected);
+        AX_CHECK(Valid || ToStd(Out) == "kept");
+        AX_CHECK(Appended.AppendFromHex(Hex.data(), Hex.size(), &Offset)
+            == Valid);
+        AX_CHECK(Offset == Expected);
+        AX_CHECK(Valid || ToStd(Appended) == "kept");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Repeated appends grow the capacity geometrically.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testGrowth(void)
+{
+    const std::string Bytes(37, '\x5A');
+    TString Str;
+
+    const TAllocations Made = CountAllocations([&]()
+    {
+        for (int i = 0; i < 10000; ++i)
+            Str.AppendHex(Bytes.data(), Bytes.size());
+    });
+
+    AX_CHECK(Str.Length() == 10000 * 74);
+    AX_CHECK(Made.NewArray < 40);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRoundTrip();
+    _testInvalid();
+    _testGrowth();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include <random>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+static unsigned char _fold(char Ch)
+{
+    const unsigned char Byte = static_cast<unsigned char>(Ch);
+
+    return (Byte >= 'A' && Byte <= 'Z' ? Byte + 32 : Byte);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _folded(std::string Str)
+{
+    for (char& Ch : Str)
+        Ch = static_cast<char>(_fold(Ch));
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Bytes next to the letter ranges, NULs and high bytes, which must
+/// only match themselves.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomText(std::mt19937& Rng, size_t Len)
+{
+    static const char Bytes[] = {'a', 'A', 'b', 'B', 'z', 'Z', '@', '[',
+        '`', '{', '\0', '\xC4', '\xE4'};
+    std::string Str(Len, '\0');
+
+    for (char& Ch : Str)
+        Ch = Bytes[Rng() % (Rng() % 2 ? 4 : sizeof(Bytes))];
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Compares every call with the same call on folded copies.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(29);
+
+    for (int Round = 0; Round < 20000; ++Round)
+    {
+        const std::string Hay = _randomText(Rng, Rng() % 200);
+        std::string Needle = _randomText(Rng, 1 + Rng() % 6);
+        if (Rng() % 2 && Hay.size() > 8)
+        {
+            Needle = Hay.substr(Rng() % (Hay.size() - 8), 1 + Rng() % 8);
+            for (char& Ch : Needle)
+                Ch = Rng() % 2 ? static_cast<char>(std::toupper(Ch)) : Ch;
+        }
+        const size_t Pos = Rng() % (Hay.size() + 2);
+        const TString Str = MakeString(Hay);
+        const TString Other = MakeString(Needle);
+        const std::string FoldedHay = _folded(Hay);
+        const std::string FoldedNeedle = _folded(Needle);
+
+        const size_t Expected = Pos > Hay.size() ? TString::npos
+            : FoldedHay.find(FoldedNeedle, Pos);
+        AX_CHECK(Str.FindIgnoreCase(Other, Pos) ==
+            (Expected == std::string::npos ? TString::npos : Expected));
+        AX_CHECK(Str.EqualsIgnoreCase(Other) == (FoldedHay == FoldedNeedle));
+        AX_CHECK(Str.StartsWithIgnoreCase(Other) ==
+            (FoldedHay.compare(0, FoldedNeedle.size(), FoldedNeedle) == 0));
+
+        const int Order = Str.CompareIgnoreCase(Other);
+        const int Reference = FoldedHay.compare(FoldedNeedle);
+        AX_CHECK((Order < 0) == (Reference < 0));
+        AX_CHECK((Order > 0) == (Reference > 0));
+
+        bool Ascii = true;
+        for (char Ch : Hay)
+            Ascii = Ascii && static_cast<unsigned char>(Ch) < 0x80;
+        AX_CHECK(Str.IsAscii() == Ascii);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Long inputs that run the vector loops, and the C string forms.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testLong(void)
+{
+    std::string Hay(5000, 'x');
+    Hay.replace(4000, 13, "Content-TYPE:");
+    const TString Str = MakeString(Hay);
+
+    AX_CHECK(Str.FindIgnoreCase("content-type:") == 4000);
+    AX_CHECK(Str.FindIgnoreCase("CONTENT-type:", 4001) == TString::npos);
+    AX_CHECK(Str.FindIgnoreCase(MakeString(std::string("x\0", 2)))
+        == TString::npos);
+    AX_CHECK(Str.EqualsIgnoreCase(_folded(Hay).c_str()));
+    AX_CHECK(!Str.EqualsIgnoreCase(Hay.substr(0, 4999).c_str()));
+    AX_CHECK(Str.StartsWithIgnoreCase("XXX"));
+    AX_CHECK(Str.CompareIgnoreCase(MakeString(_folded(Hay))) == 0);
+
+    Hay[4500] = '\xE4';
+    AX_CHECK(!MakeString(Hay).IsAscii());
+    AX_CHECK(!MakeString(Hay).EqualsIgnoreCase(MakeString(_folded(Hay) +
+        std::string(1, '\0'))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRandom();
+    _testLong();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "CountNew.hpp"
+#include <array>
+#include <random>
+#include <string_view>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _reference(const std::string& Sep,
+    const std::vector<std::string>& Pieces)
+{
+    std::string Result;
+
+    for (size_t i = 0; i < Pieces.size(); ++i)
+        Result += (i ? Sep : std::string()) + Pieces[i];
+    return (Result);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Joins the same pieces held as every supported type, and checks that
+/// each join makes exactly one allocation.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testTypes(void)
+{
+    std::mt19937 Rng(49);
+
+    for (int Round = 0; Round < 2000; ++Round)
+    {
+        std::vector<std::string> Pieces(Rng() % 8);
+        std::string Sep(Rng() % 4, ',');
+
+        for (std::string& Piece : Pieces)
+            Piece.assign(Rng() % 40, static_cast<char>('a' + Rng() % 26));
+
+        const std::string Expected = _reference(Sep, Pieces);
+        std::vector<TString> Strings;
+        std::vector<std::string_view> Views;
+        std::vector<const char*> CStrings;
+
+        for (const std::string& Piece : Pieces)
+        {
+            Strings.push_back(MakeString(Piece));
+            Views.push_back(Piece);
+            CStrings.push_back(Piece.c_str());
+        }
+
+        const TString TSep = MakeString(Sep);
+        const std::string_view VSep = Sep;
+        TString Result;
+        TAllocations Made;
+
+        Made = CountAllocations([&]()
+        {
+            Result = TString::Join(TSep, Strings);
+        });
+        AX_CHECK(ToStd(Result) == Expected);
+        AX_CHECK(Made.New == 0 && Made.NewArray == 1);
+        Made = CountAllocations([&]() { Result = TString::Join(Sep, Pieces); });
+        AX_CHECK(ToStd(Result) == Expected);
+        AX_CHECK(Made.New == 0 && Made.NewArray == 1);
+        Made = CountAllocations([&]() { Result = TString::Join(VSep, Views); });
+        AX_CHECK(ToStd(Result) == Expected);
+        AX_CHECK(Made.New == 0 && Made.NewArray == 1);
+        Made = CountAllocations([&]()
+        {
+            Result = TString::Join(Sep.c_str(), CStrings);
+        });
+        AX_CHECK(ToStd(Result) == Expected);
+        AX_CHECK(Made.New == 0 && Made.NewArray == 1);
+    }
+
+    const std::array<const char*, 3> Fixed = {"a", "", "c"};
+
+    AX_CHECK(ToStd(TString::Join("--", Fixed)) == "a----c");
+    AX_CHECK(ToStd(TString::Join(TString(", "), std::vector<TString>()))
+        == "");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// A result past 16 MiB is copied by several threads; it must still be
+/// the only array allocation.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testParallel(void)
+{
+    std::vector<std::string> Pieces;
+    std::vector<TString> Strings;
+    size_t Size = 0;
+
+    for (size_t i = 0; Size < (size_t(1) << 24) + 12345; ++i)
+    {
+        Pieces.emplace_back(1 + (i * 7919) % 3001,
+            static_cast<char>('a' + i % 26));
+        Strings.push_back(MakeString(Pieces.back()));
+        Size += Pieces.back().size() + 2;
+    }
+
+    const std::string Expected = _reference("; ", Pieces);
+
+    for (size_t Threads : {size_t(1), size_t(3), size_t(8)})
+    {
+        TString Result;
+        const TAllocations Made = CountAllocations([&]()
+        {
+            Result = TString::Join("; ", Strings, Threads);
+        });
+
+        AX_CHECK(ToStd(Result) == Expected);
+        AX_CHECK(Made.NewArray == 1);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testTypes();
+    _testParallel();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "CountNew.hpp"
+#include <cstring>
+#include <random>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+static const size_t _none = static_cast<size_t>(-1);
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _reference(const std::string& Bytes)
+{
+    std::string Escaped;
+    char Escape[8];
+
+    for (char Ch : Bytes)
+    {
+        switch (Ch)
+        {
+            case '"': Escaped += "\\\""; break;
+            case '\\': Escaped += "\\\\"; break;
+            case '\b': Escaped += "\\b"; break;
+            case '\f': Escaped += "\\f"; break;
+            case '\n': Escaped += "\\n"; break;
+            case '\r': Escaped += "\\r"; break;
+            case '\t': Escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(Ch) < 0x20)
+                {
+                    std::snprintf(Escape, sizeof(Escape), "\\u%04x", Ch);
+                    Escaped += Escape;
+                }
+                else
+                    Escaped += Ch;
+        }
+    }
+    return (Escaped);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Random bytes with many characters to escape, and long clean spans for
+/// the vector path, escaped and unescaped back.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRoundTrip(void)
+{
+    std::mt19937 Rng(47);
+
+    for (int Round = 0; Round < 10000; ++Round)
+    {
+        const size_t Len = Rng() % (Round % 5 ? 80 : 700);
+        std::string Bytes;
+
+        for (size_t i = 0; i < Len; ++i)
+        {
+            Bytes += Round % 2 && Rng() % 32 ? static_cast<char>('a' + i % 26)
+                : static_cast<char>(Rng());
+        }
+
+        const std::string Expected = _reference(Bytes);
+        const TString Str = MakeString(Bytes);
+        TString Escaped("[");
+
+        Str.JsonEscapeAppend(Escaped);
+        AX_CHECK(ToStd(Escaped) == "[" + Expected);
+
+        TString Self = Str;
+        Self.JsonEscapeAppend(Self);
+        AX_CHECK(ToStd(Self) == Bytes + Expected);
+
+        TString Out("old");
+        size_t Offset = 0;
+
+        AX_CHECK(TString::JsonUnescape(Expected.data(), Expected.size(), Out,
+            &Offset));
+        AX_CHECK(ToStd(Out) == Bytes && Offset == _none);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Building a document one field at a time grows the buffer geometrically.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testGrowth(void)
+{
+    const TString Field("line\n\"quoted\"\t");
+    TString Document;
+
+    const TAllocations Made = CountAllocations([&]()
+    {
+        for (int i = 0; i < 10000; ++i)
+            Field.JsonEscapeAppend(Document);
+    });
+
+    AX_CHECK(Document.Length() == 10000 * 18);
+    AX_CHECK(Made.NewArray < 40);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testUnescape(void)
+{
+    struct FCase
+    {
+        const char* Input;
+        const char* Output;
+        size_t Offset;
+    };
+    static const FCase Cases[] = {
+        {"a\\/b\\u0041\\u00e9", "a/bA\xC3\xA9", _none},
+        {"\\u20AC\\ud83d\\ude00", "\xE2\x82\xAC\xF0\x9F\x98\x80", _none},
+        {"\\uD800", nullptr, 0},
+        {"ab\\udc00", nullptr, 2},
+        {"\\ud83d\\u0041", nullptr, 0},
+        {"\\ud83d\\ud83d", nullptr, 0},
+        {"x\\u12G4", nullptr, 1},
+        {"x\\u12", nullptr, 1},
+        {"\\x", nullptr, 0},
+        {"ab\\", nullptr, 2},
+        {"a\"b", nullptr, 1},
+        {"a\x1F", nullptr, 1},
+        {"\xC3\xA9\x7F", "\xC3\xA9\x7F", _none},
+    };
+
+    for (const FCase& Case : Cases)
+    {
+        const size_t Len = std::strlen(Case.Input);
+        TString Out("kept");
+        TString Appended("kept");
+        size_t Offset = 0;
+
+        AX_CHECK(TString::JsonUnescape(Case.Input, Len, Out, &Offset)
+            == (Case.Output != nullptr));
+        AX_CHECK(Offset == Case.Offset);
+        AX_CHECK(ToStd(Out) == (Case.Output ? Case.Output : "kept"));
+        AX_CHECK(Appended.AppendJsonUnescape(Case.Input, Len, &Offset)
+            == (Case.Output != nullptr));
+        AX_CHECK(ToStd(Appended)
+            == (Case.Output ? "kept" + std::string(Case.Output) : "kept"));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRoundTrip();
+    _testGrowth();
+    _testUnescape();
+    std::puts("ok");
+    return (0);
+}
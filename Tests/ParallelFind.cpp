@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+static const size_t _chunk = size_t(1) << 20;
+
+///////////////////////////////////////////////////////////////////////////////
+static std::vector<size_t> _findAll(const std::string& Hay,
+    const std::string& Needle)
+{
+    std::vector<size_t> Found;
+
+    for (size_t At = Hay.find(Needle); At != std::string::npos;
+        At = Hay.find(Needle, At + Needle.size()))
+        Found.push_back(At);
+    return (Found);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _check(const std::string& Hay, const std::string& Needle)
+{
+    const TString Str = MakeString(Hay);
+    const TString Sub = MakeString(Needle);
+    const std::vector<size_t> Expected = _findAll(Hay, Needle);
+
+    for (size_t Threads : {size_t(0), size_t(2), size_t(3), size_t(8)})
+    {
+        AX_CHECK(Str.ParallelFind(Sub, Threads) == Hay.find(Needle));
+        AX_CHECK(Str.ParallelFindAll(Sub, Threads) == Expected);
+        AX_CHECK(Str.ParallelCount(Sub, Threads) == Expected.size());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Periodic text, where a chunk scanned from its own start reports
+/// occurrences shifted against the greedy scan from the beginning.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testPeriodic(void)
+{
+    std::string Hay(3 * _chunk + 12345, 'a');
+
+    _check(Hay, "a");
+    _check(Hay, "aa");
+    _check(Hay, "aaa");
+    _check(Hay, std::string(1000, 'a'));
+    Hay[_chunk + 1] = 'b';
+    Hay[2 * _chunk] = 'b';
+    _check(Hay, "aaa");
+    _check(Hay, "aba");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Needles planted on and across the chunk boundaries, at the very end,
+/// and nowhere.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testBoundaries(void)
+{
+    std::mt19937 Rng(32);
+    std::string Hay(4 * _chunk + 77, 'x');
+
+    for (char& Ch : Hay)
+        Ch = static_cast<char>('c' + Rng() % 20);
+
+    const std::string Needle = "needle-ab";
+
+    _check(Hay, Needle);
+    for (size_t Boundary = 1; Boundary <= 3; ++Boundary)
+    {
+        for (size_t Back = 0; Back <= Needle.size(); Back += 4)
+            Hay.replace(Boundary * _chunk - Back, Needle.size(), Needle);
+    }
+    Hay.replace(Hay.size() - Needle.size(), Needle.size(), Needle);
+    _check(Hay, Needle);
+    _check(Hay, "ab");
+    _check(Hay, "e");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testSmall(void)
+{
+    _check("", "a");
+    _check("abcabc", "bc");
+    _check("abc", "abcd");
+    _check(std::string(100, 'a'), "aa");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testSmall();
+    _testPeriodic();
+    _testBoundaries();
+    std::puts("ok");
+    return (0);
+}
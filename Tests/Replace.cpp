@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "CountNew.hpp"
+#include <random>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomText(std::mt19937& Rng, size_t Len)
+{
+    std::string Str;
+
+    for (size_t i = 0; i < Len; ++i)
+        Str += Rng() % 4 ? 'a' : 'b';
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _replaceAll(const std::string& Str, const std::string& From,
+    const std::string& To)
+{
+    std::string Result;
+    size_t At = 0;
+
+    if (From.empty())
+        return (Str);
+    for (size_t Next; (Next = Str.find(From, At)) != std::string::npos;
+        At = Next + From.size())
+        Result += Str.substr(At, Next - At) + To;
+    return (Result + Str.substr(At));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Shrinking, equal and growing replacements against a reference; the
+/// first two must not allocate and the last at most once.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(28);
+
+    for (int Round = 0; Round < 20000; ++Round)
+    {
+        const std::string Bytes = _randomText(Rng, Rng() % 300);
+        const std::string From = _randomText(Rng, Rng() % 5);
+        const std::string To = _randomText(Rng, Rng() % 8);
+        const std::string Expected = _replaceAll(Bytes, From, To);
+        TString Str = MakeString(Bytes);
+        const TString TFrom = MakeString(From);
+        const TString TTo = MakeString(To);
+
+        const TAllocations Made = CountAllocations([&]()
+        {
+            Str.ReplaceAll(TFrom, TTo);
+        });
+
+        AX_CHECK(ToStd(Str) == Expected);
+        AX_CHECK(Made.NewArray <= (To.size() > From.size() ? 1u : 0u));
+
+        Str = MakeString(Bytes);
+        Str.ReplaceAll(From.c_str(), To.c_str());
+        AX_CHECK(ToStd(Str) == Expected);
+
+        std::string Chars = Bytes;
+
+        for (char& Ch : Chars)
+            Ch = Ch == 'a' ? 'c' : Ch;
+        Str = MakeString(Bytes);
+        AX_CHECK(CountAllocations([&]() { Str.ReplaceAll('a', 'c'); })
+            .NewArray == 0);
+        AX_CHECK(ToStd(Str) == Chars);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Arguments that point into the string being changed.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testAliasing(void)
+{
+    TString Str("abcabc");
+
+    Str.ReplaceAll(Str, Str);
+    AX_CHECK(ToStd(Str) == "abcabc");
+    Str.ReplaceAll("b", Str.CStr());
+    AX_CHECK(ToStd(Str) == "aabcabccaabcabcc");
+
+    TString Short("xyzxyz");
+
+    Short.ReplaceAll("xyz", Short.CStr() + 4);
+    AX_CHECK(ToStd(Short) == "yzyz");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRandom();
+    _testAliasing();
+    std::puts("ok");
+    return (0);
+}
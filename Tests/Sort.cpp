@@ -0,0 +1,250 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include <algorithm>
+#include <cstring>
+#include <pthread.h>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Byte order on unsigned bytes, the order `Sort` promises.
+///
+///////////////////////////////////////////////////////////////////////////////
+static bool _byteLess(const std::string& A, const std::string& B)
+{
+    const size_t Len = std::min(A.size(), B.size());
+    const int Diff = Len ? std::memcmp(A.data(), B.data(), Len) : 0;
+
+    return (Diff ? Diff < 0 : A.size() < B.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sorts with `Sort` or `ParallelSort` and checks the order and the
+/// LCP values against `std::sort`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _checkSort(std::vector<std::string> Bytes, size_t Threads)
+{
+    std::vector<TString> Strings;
+    std::vector<size_t> Lcp;
+
+    for (const std::string& Str : Bytes)
+        Strings.push_back(MakeString(Str));
+    if (Threads)
+        TString::ParallelSort(Strings, Threads, &Lcp);
+    else
+        TString::Sort(Strings, &Lcp);
+    std::sort(Bytes.begin(), Bytes.end(), _byteLess);
+
+    AX_CHECK(Strings.size() == Bytes.size());
+    AX_CHECK(Lcp.size() == Bytes.size());
+    for (size_t i = 0; i < Bytes.size(); ++i)
+    {
+        AX_CHECK(ToStd(Strings[i]) == Bytes[i]);
+        size_t Common = 0;
+        while (i && Common < Bytes[i].size() && Common < Bytes[i - 1].size()
+            && Bytes[i][Common] == Bytes[i - 1][Common])
+            ++Common;
+        AX_CHECK(Lcp[i] == Common);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Random inputs: short strings over small and full alphabets, with
+/// NULs, high bytes and long shared prefixes.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(4);
+
+    for (int Round = 0; Round < 400; ++Round)
+    {
+        const size_t Count = Round < 350 ? Rng() % 200 : 20000 + Rng() % 30000;
+        const int Mode = Rng() % 4;
+        std::vector<std::string> Bytes(Count);
+
+        for (std::string& Str : Bytes)
+        {
+            const size_t Len = Rng() % (Mode == 3 ? 40 : 12);
+            if (Mode == 2)
+                Str = "a/common/prefix/longer/than/eight/bytes/";
+            for (size_t i = 0; i < Len; ++i)
+            {
+                Str += Mode == 0 ? char(Rng() % 3) : Mode == 1
+                    ? char(Rng() % 256) : char('a' + Rng() % 3);
+            }
+        }
+        _checkSort(Bytes, Round % 2 ? 2 + Round % 3 : 0);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Builds an input on which the pivot rule of `Sort` keeps picking
+/// one of the smallest or largest items, after McIlroy's "killer adversary
+/// for quicksort".
+///
+/// The sort is replayed here on indices: values are left undecided ("gas")
+/// until a comparison needs them, and are then frozen so that the pivot
+/// ends up near an extreme. The replay mirrors the first-level partition
+/// of `Sort`: median of the first, middle and last items, three-way
+/// partition, insertion sort below 16 items, and a loop on the larger part
+/// after sorting the smaller one.
+///
+///////////////////////////////////////////////////////////////////////////////
+struct _Adversary
+{
+    std::vector<size_t> Value;
+    size_t Gas;
+    size_t Solid = 0;
+    size_t Candidate = 0;
+
+    explicit _Adversary(size_t Count) : Value(Count, Count), Gas(Count) {}
+
+    bool Less(size_t A, size_t B)
+    {
+        if (Value[A] == Gas && Value[B] == Gas)
+            Value[A == Candidate ? A : B] = Solid++;
+        if (Value[A] == Gas)
+            Candidate = A;
+        else if (Value[B] == Gas)
+            Candidate = B;
+        return (Value[A] < Value[B]);
+    }
+
+    void Sort(size_t* Items, size_t Count)
+    {
+        while (Count > 1)
+        {
+            if (Count < 16)
+            {
+                for (size_t i = 1; i < Count; ++i)
+                {
+                    const size_t Item = Items[i];
+                    size_t j = i;
+                    for (; j > 0 && Less(Item, Items[j - 1]); --j)
+                        Items[j] = Items[j - 1];
+                    Items[j] = Item;
+                }
+                return;
+            }
+
+            size_t Pivot = Items[Count / 2];
+            const size_t First = Items[0];
+            const size_t Last = Items[Count - 1];
+            if (Less(First, Pivot) != Less(First, Last))
+                Pivot = First;
+            else if (Less(Last, Pivot) != Less(Last, First))
+                Pivot = Last;
+
+            size_t Lower = 0;
+            size_t Upper = Count;
+            for (size_t i = 0; i < Upper;)
+            {
+                if (Less(Items[i], Pivot))
+                    std::swap(Items[Lower++], Items[i++]);
+                else if (Less(Pivot, Items[i]))
+                    std::swap(Items[i], Items[--Upper]);
+                else
+                    i++;
+            }
+            if (Lower < Count - Upper)
+            {
+                Sort(Items, Lower);
+                Items += Upper;
+                Count -= Upper;
+            }
+            else
+            {
+                Sort(Items + Upper, Count - Upper);
+                Count = Lower;
+            }
+        }
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+static std::vector<std::string> _adversarialInput(size_t Count)
+{
+    _Adversary Adversary(Count);
+    std::vector<size_t> Items(Count);
+    std::vector<std::string> Bytes(Count);
+
+    for (size_t i = 0; i < Count; ++i)
+        Items[i] = i;
+    Adversary.Sort(Items.data(), Count);
+    // Eight big-endian bytes per value, so the first level decides it all.
+    for (size_t i = 0; i < Count; ++i)
+    {
+        for (int Shift = 56; Shift >= 0; Shift -= 8)
+            Bytes[i] += char((Adversary.Value[i] >> Shift) & 0xFF);
+    }
+    return (Bytes);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void* _sortOnSmallStack(void* Input)
+{
+    _checkSort(*static_cast<std::vector<std::string>*>(Input), 0);
+    return (nullptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sorts the adversarial input on a 128 KiB stack: recursing into
+/// every partition needs a frame per item here and overflows it.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testAdversarial(void)
+{
+    std::vector<std::string> Bytes = _adversarialInput(6000);
+    pthread_attr_t Attr;
+    pthread_t Thread;
+
+    AX_CHECK(pthread_attr_init(&Attr) == 0);
+    AX_CHECK(pthread_attr_setstacksize(&Attr, 128 << 10) == 0);
+    AX_CHECK(pthread_create(&Thread, &Attr, _sortOnSmallStack, &Bytes) == 0);
+    AX_CHECK(pthread_join(Thread, nullptr) == 0);
+    pthread_attr_destroy(&Attr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRandom();
+    _testAdversarial();
+    _checkSort({}, 0);
+    _checkSort({std::string(1, '\0'), std::string(), std::string(2, '\0')}, 0);
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "CountNew.hpp"
+#include <random>
+#include <string_view>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+typedef std::vector<std::string_view> FTokens;
+
+///////////////////////////////////////////////////////////////////////////////
+static const size_t _none = static_cast<size_t>(-1);
+
+///////////////////////////////////////////////////////////////////////////////
+/// Delimiter runs and long tokens, so the vector searches run several
+/// blocks, with NUL and high bytes mixed in.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomText(std::mt19937& Rng)
+{
+    static const char Bytes[] = {'a', 'b', ',', ';', '\0', '\x85'};
+    const size_t Len = Rng() % (Rng() % 4 ? 24 : 300);
+    const unsigned Dense = Rng() % 3 ? 6 : 2;
+    std::string Str;
+
+    for (size_t i = 0; i < Len; ++i)
+        Str += Bytes[Rng() % Dense];
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Reference tokenizer: `Delims` are either single bytes (`Any`) or one
+/// separator, found with `std::string_view::find`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static FTokens _split(std::string_view Str, const std::string& Delims,
+    bool Any, bool SkipEmpty, size_t MaxSplits)
+{
+    const size_t Width = Any ? 1 : Delims.size();
+    FTokens Tokens;
+    size_t Pos = 0;
+    size_t Splits = 0;
+
+    auto At = [&](size_t i)
+    {
+        if (Any)
+            return (Delims.find(Str[i]) != std::string::npos);
+        return (!Delims.empty() && Str.substr(i, Width) == Delims);
+    };
+    auto Next = [&](size_t From)
+    {
+        if (!Any)
+            return (Delims.empty() ? std::string_view::npos
+                : Str.find(Delims, From));
+        for (size_t i = From; i < Str.size(); ++i)
+        {
+            if (At(i))
+                return (i);
+        }
+        return (std::string_view::npos);
+    };
+
+    while (true)
+    {
+        while (SkipEmpty && Pos < Str.size() && At(Pos))
+            Pos += Width;
+        if (SkipEmpty && Pos == Str.size())
+            break;
+
+        const size_t Hit = Splits < MaxSplits ? Next(Pos)
+            : std::string_view::npos;
+
+        if (Hit == std::string_view::npos)
+        {
+            Tokens.push_back(Str.substr(Pos));
+            break;
+        }
+        Tokens.push_back(Str.substr(Pos, Hit - Pos));
+        Pos = Hit + Width;
+        Splits++;
+    }
+    return (Tokens);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Every token must be a view into `Str`, in order and without overlap.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _checkViews(const TString& Str, const FTokens& Tokens)
+{
+    const char* Last = Str.CStr();
+
+    for (const std::string_view& Token : Tokens)
+    {
+        AX_CHECK(Token.data() >= Last);
+        AX_CHECK(Token.data() + Token.size() <= Str.CStr() + Str.Length());
+        Last = Token.data() + Token.size();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    static const std::string Seps[] = {",", ",;", ";;;",
+        std::string(",\0", 2)};
+    static const char* const Sets[] = {",", ",;", ";\0", ",\x85", "\x85"};
+    std::mt19937 Rng(48);
+
+    for (int Round = 0; Round < 20000; ++Round)
+    {
+        const TString Str = MakeString(_randomText(Rng));
+        const std::string_view Whole(Str.CStr(), Str.Length());
+        const bool Skip = Rng() % 2;
+        const size_t Max = Rng() % 3 ? _none : Rng() % 5;
+        const char Delim = ",;\0"[Rng() % 3];
+        const std::string& Sep = Seps[Rng() % 4];
+        const TString Set = MakeString(Sets[Rng() % 5]);
+
+        const FTokens ByChar = Str.Split(Delim, Skip, Max).ToVector();
+        const FTokens BySep = Str.Split(MakeString(Sep), Skip, Max)
+            .ToVector();
+        const FTokens ByAny = Str.SplitAny(Set, Skip, Max).ToVector();
+
+        AX_CHECK(ByChar == _split(Whole, std::string(1, Delim), true, Skip,
+            Max));
+        AX_CHECK(BySep == _split(Whole, Sep, false, Skip, Max));
+        AX_CHECK(ByAny == _split(Whole, ToStd(Set), true, Skip, Max));
+        _checkViews(Str, ByChar);
+        _checkViews(Str, BySep);
+        _checkViews(Str, ByAny);
+
+        size_t Count = 0;
+        const TAllocations Made = CountAllocations([&]()
+        {
+            for (std::string_view Token : Str.Split(Delim, Skip, Max))
+                Count += Token.size() + 1;
+            for (std::string_view Token : Str.SplitAny(Set, Skip, Max))
+                Count += Token.size() + 1;
+        });
+
+        AX_CHECK(Made.New == 0 && Made.NewArray == 0);
+        AX_CHECK(Count >= ByChar.size() + ByAny.size());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testEdges(void)
+{
+    const TString Empty;
+    const TString Csv("a,,b,");
+
+    AX_CHECK(Empty.Split(',').ToVector() == FTokens(1));
+    AX_CHECK(Empty.Split(TString(",")).ToVector() == FTokens(1));
+    AX_CHECK(Empty.SplitAny(TString(",")).ToVector() == FTokens(1));
+    AX_CHECK(Empty.Split(',', true).ToVector().empty());
+    AX_CHECK(Csv.Split(',').ToVector() == FTokens({"a", "", "b", ""}));
+    AX_CHECK(Csv.Split(',', true).ToVector() == FTokens({"a", "b"}));
+    AX_CHECK(Csv.Split(',', false, 1).ToVector() == FTokens({"a", ",b,"}));
+    AX_CHECK(Csv.Split(',', true, 1).ToVector() == FTokens({"a", "b,"}));
+    AX_CHECK(Csv.Split(',', false, 0).ToVector() == FTokens({"a,,b,"}));
+    AX_CHECK(Csv.Split(TString()).ToVector() == FTokens({"a,,b,"}));
+    AX_CHECK(TString("a::b:::c").Split(TString("::")).ToVector()
+        == FTokens({"a", "b", ":c"}));
+    AX_CHECK(TString("x, y;z").SplitAny(TString(", ;"), true).ToVector()
+        == FTokens({"x", "y", "z"}));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRandom();
+    _testEdges();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "StringMap.hpp"
+#include <map>
+#include <random>
+#include <string_view>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::THashedString;
+using Ax::TString;
+using Ax::TStringMap;
+
+///////////////////////////////////////////////////////////////////////////////
+/// Value type counting its live instances, to catch leaks and double
+/// destruction across rehashes, erasures, copies and moves.
+///
+///////////////////////////////////////////////////////////////////////////////
+struct FTracked
+{
+    static int Live;
+    int Value = 0;
+
+    FTracked(int Init = 0) : Value(Init) { ++Live; }
+    FTracked(const FTracked& Other) : Value(Other.Value) { ++Live; }
+    FTracked& operator=(const FTracked& Other) = default;
+    ~FTracked(void) { --Live; }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+int FTracked::Live = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+using FModel = std::map<std::string, int>;
+using FMap = TStringMap<FTracked>;
+
+///////////////////////////////////////////////////////////////////////////////
+static bool _same(const FMap& Map, const FModel& Model)
+{
+    FModel Seen;
+
+    Map.ForEach([&](const TString& Key, const FTracked& Value)
+    {
+        Seen.emplace(ToStd(Key), Value.Value);
+    });
+    return (Map.Size() == Model.size() && Map.IsEmpty() == Model.empty()
+        && Seen == Model);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Random operations through every key type against std::map, with a
+/// small key space so that erasures leave many tombstones behind.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(37);
+    FMap Map;
+    FModel Model;
+
+    for (int Step = 0; Step < 200000; ++Step)
+    {
+        std::string Key = "k" + std::to_string(Rng() % 3000);
+
+        if (Rng() % 16 == 0)
+            Key += std::string(1, '\0') + "nul";
+
+        const TString TKey = MakeString(Key);
+        const std::string_view View(Key);
+        const THashedString Hashed(TKey, Rng() % 2 ? Map.Seed() : 1);
+        const unsigned Via = Rng() % 4;
+        const unsigned Op = Rng() % 10;
+
+        if (Op < 4)
+        {
+            const bool Inserted = Via == 0 ? Map.Insert(TKey, Step)
+                : Via == 1 ? Map.Insert(View, Step)
+                : Via == 2 ? Map.Insert(Hashed, Step)
+                : Map.Insert(Key.c_str(), Step);
+            // A C string stops at the embedded NUL.
+            const std::string Stored = Via == 3 ? Key.c_str() : Key;
+            const bool Expected = Model.emplace(Stored, Step).second;
+
+            AX_CHECK(Inserted == Expected);
+        }
+        else if (Op < 6)
+        {
+            const bool Erased = Via == 0 ? Map.Erase(TKey)
+                : Via == 1 ? Map.Erase(View) : Map.Erase(Hashed);
+
+            AX_CHECK(Erased == (Model.erase(Key) == 1));
+        }
+        else if (Op < 7)
+        {
+            Map[View].Value = Step;
+            Model[Key] = Step;
+        }
+        else
+        {
+            const FTracked* Found = Via == 0 ? Map.Find(TKey)
+                : Via == 1 ? Map.Find(View) : Map.Find(Hashed);
+            const auto It = Model.find(Key);
+
+            AX_CHECK((Found != nullptr) == (It != Model.end()));
+            AX_CHECK(!Found || Found->Value == It->second);
+            AX_CHECK(Map.Contains(TKey) == (It != Model.end()));
+        }
+        if (Step % 20000 == 0)
+            AX_CHECK(_same(Map, Model));
+    }
+    AX_CHECK(_same(Map, Model));
+    AX_CHECK(FTracked::Live == static_cast<int>(Model.size()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testCopyMove(void)
+{
+    FModel Model;
+
+    {
+        FMap Map;
+
+        Map.Reserve(1000);
+        for (int i = 0; i < 1000; ++i)
+        {
+            Map.Insert(TString::From(i), i);
+            Model.emplace(std::to_string(i), i);
+        }
+
+        FMap Copy(Map);
+        FMap Assigned;
+
+        Assigned.Insert("stale", 0);
+        Assigned = Copy;
+        AX_CHECK(_same(Copy, Model) && _same(Assigned, Model));
+
+        FMap Moved(std::move(Copy));
+        AX_CHECK(_same(Moved, Model));
+        Assigned = std::move(Moved);
+        AX_CHECK(_same(Assigned, Model));
+        const FMap& Self = Assigned;
+        Assigned = Self;
+        AX_CHECK(_same(Assigned, Model));
+        AX_CHECK(FTracked::Live == static_cast<int>(Map.Size() + Copy.Size()
+            + Moved.Size() + Assigned.Size()));
+
+        Map.Clear();
+        AX_CHECK(_same(Map, FModel()));
+        AX_CHECK(!Map.Contains("1") && Map.Insert("1", 1));
+    }
+    AX_CHECK(FTracked::Live == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRandom();
+    _testCopyMove();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "SuffixIndex.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+using Ax::TSuffixIndex;
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomText(std::mt19937& Rng, size_t Len, unsigned Sigma)
+{
+    static const char Bytes[] = {'a', 'b', '\0', '\xFF', 'c', 'd', 'e', 'f'};
+    std::string Str;
+
+    for (size_t i = 0; i < Len; ++i)
+        Str += Bytes[Rng() % Sigma];
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static size_t _lcp(const std::string& Text, size_t A, size_t B)
+{
+    size_t Len = 0;
+
+    while (A + Len < Text.size() && B + Len < Text.size()
+        && Text[A + Len] == Text[B + Len])
+        ++Len;
+    return (Len);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Suffixes sorted by std::string comparison, which orders bytes as
+/// unsigned and puts a prefix first.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _checkArrays(const std::string& Text, const TSuffixIndex& Index)
+{
+    std::vector<size_t> Expected(Text.size());
+
+    std::iota(Expected.begin(), Expected.end(), 0);
+    std::sort(Expected.begin(), Expected.end(), [&](size_t A, size_t B)
+    {
+        return (Text.compare(A, std::string::npos, Text, B,
+            std::string::npos) < 0);
+    });
+    AX_CHECK(Index.SuffixArray() == Expected);
+    AX_CHECK(Index.LcpArray().size() == Text.size());
+    for (size_t i = 0; i < Expected.size(); ++i)
+    {
+        AX_CHECK(Index.LcpArray()[i]
+            == (i ? _lcp(Text, Expected[i - 1], Expected[i]) : 0));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _checkQueries(std::mt19937& Rng, const std::string& Text,
+    const TSuffixIndex& Index)
+{
+    for (int Query = 0; Query < 20; ++Query)
+    {
+        std::string Pattern = _randomText(Rng, Rng() % 6, 3);
+
+        if (Query % 2 && !Text.empty())
+            Pattern = Text.substr(Rng() % Text.size(), 1 + Rng() % 8);
+
+        std::vector<size_t> Expected;
+
+        for (size_t i = 0; !Pattern.empty()
+            && i + Pattern.size() <= Text.size(); ++i)
+        {
+            if (Text.compare(i, Pattern.size(), Pattern) == 0)
+                Expected.push_back(i);
+        }
+        AX_CHECK(Index.Count(MakeString(Pattern)) == Expected.size());
+        AX_CHECK(Index.Locate(MakeString(Pattern)) == Expected);
+    }
+
+    size_t Longest = 0;
+    size_t Pos = 0;
+    const TString Repeated = Index.LongestRepeatedSubstring(&Pos);
+
+    for (size_t i = 1; i < Index.LcpArray().size(); ++i)
+        Longest = std::max(Longest, Index.LcpArray()[i]);
+    AX_CHECK(Repeated.Length() == Longest);
+    if (Longest)
+    {
+        const std::string Sub = ToStd(Repeated);
+
+        AX_CHECK(Text.compare(Pos, Longest, Sub) == 0);
+        AX_CHECK(Text.find(Sub, Text.find(Sub) + 1) != std::string::npos);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(33);
+
+    for (int Round = 0; Round < 400; ++Round)
+    {
+        const unsigned Sigma = 1 + Rng() % 8;
+        const std::string Text = _randomText(Rng, Rng() % 400, Sigma);
+        const TSuffixIndex Index(MakeString(Text));
+
+        AX_CHECK(ToStd(Index.Text()) == Text);
+        _checkArrays(Text, Index);
+        _checkQueries(Rng, Text, Index);
+    }
+
+    // Long runs of one character are the worst case of prefix doubling.
+    const std::string Run(5000, 'a');
+    _checkArrays(Run, TSuffixIndex(MakeString(Run)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testSaveLoad(void)
+{
+    const char* Path = "TestSuffixIndex.bin";
+    std::mt19937 Rng(34);
+    const std::string Text = _randomText(Rng, 1000, 4);
+    const TSuffixIndex Index(MakeString(Text));
+    TSuffixIndex Loaded(TString("other"));
+
+    AX_CHECK(Index.Save(TString(Path)));
+    AX_CHECK(Loaded.Load(TString(Path)));
+    AX_CHECK(ToStd(Loaded.Text()) == Text);
+    AX_CHECK(Loaded.SuffixArray() == Index.SuffixArray());
+    AX_CHECK(Loaded.LcpArray() == Index.LcpArray());
+
+    // A truncated file is rejected and leaves the index as it was.
+    std::vector<char> Bytes(1 << 16);
+    std::FILE* File = std::fopen(Path, "rb");
+    AX_CHECK(File);
+    Bytes.resize(std::fread(Bytes.data(), 1, Bytes.size(), File));
+    std::fclose(File);
+    File = std::fopen(Path, "wb");
+    AX_CHECK(File);
+    std::fwrite(Bytes.data(), 1, Bytes.size() / 2, File);
+    std::fclose(File);
+
+    TSuffixIndex Kept(TString("kept"));
+    AX_CHECK(!Kept.Load(TString(Path)));
+    AX_CHECK(ToStd(Kept.Text()) == "kept" && Kept.Count(TString("e")) == 1);
+    AX_CHECK(!Kept.Load(TString("does/not/exist")));
+    std::remove(Path);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRandom();
+    _testSaveLoad();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "CountNew.hpp"
+#include <random>
+#include <string_view>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+
+///////////////////////////////////////////////////////////////////////////////
+static const std::string _space = " \t\n\v\f\r";
+
+///////////////////////////////////////////////////////////////////////////////
+/// Long whitespace runs, so the vector loops run several blocks, around a
+/// middle that may hold NUL, high bytes and more whitespace.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::string _randomText(std::mt19937& Rng)
+{
+    static const char Others[] = {'a', '\0', '\x85', '\xA0', '_'};
+    std::string Str;
+
+    for (int Part = 0; Part < 3; ++Part)
+    {
+        const size_t Len = Rng() % (Rng() % 4 ? 20 : 200);
+
+        for (size_t i = 0; i < Len; ++i)
+        {
+            Str += Part != 1 || Rng() % 3 == 0 ? _space[Rng() % 6]
+                : Others[Rng() % 5];
+        }
+    }
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string_view _trim(std::string_view Str, const std::string& Set,
+    bool Left, bool Right)
+{
+    while (Left && !Str.empty() && Set.find(Str.front()) != std::string::npos)
+        Str.remove_prefix(1);
+    while (Right && !Str.empty() && Set.find(Str.back()) != std::string::npos)
+        Str.remove_suffix(1);
+    return (Str);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Views must point into the string, in-place trims must neither allocate
+/// nor release the capacity.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(41);
+
+    for (int Round = 0; Round < 20000; ++Round)
+    {
+        const std::string Bytes = _randomText(Rng);
+        const TString Str = MakeString(Bytes);
+        const std::string_view Whole(Str.Length() ? Str.CStr() : "",
+            Str.Length());
+
+        AX_CHECK(Str.TrimView() == _trim(Whole, _space, true, true));
+        AX_CHECK(Str.TrimLeftView() == _trim(Whole, _space, true, false));
+        AX_CHECK(Str.TrimRightView() == _trim(Whole, _space, false, true));
+        AX_CHECK(Str.TrimView().empty() || Str.TrimView().data() >= Str.CStr());
+
+        std::string Set;
+
+        for (size_t i = 0, n = Rng() % 4; i < n; ++i)
+            Set += "\0 a\x85\t"[Rng() % 5];
+
+        const TString TSet = MakeString(Set);
+        const std::string_view Chars = _trim(Whole, Set, true, true);
+
+        AX_CHECK(Str.TrimCharsView(TSet) == Chars);
+
+        TString Both = Str;
+        TString Left = Str;
+        TString Right = Str;
+        TString Custom = Str;
+        const size_t Capacity = Both.Capacity();
+        const TAllocations Made = CountAllocations([&]()
+        {
+            Both.Trim();
+            Left.TrimLeft();
+            Right.TrimRight();
+            Custom.TrimChars(TSet);
+        });
+
+        AX_CHECK(Made.New == 0 && Made.NewArray == 0);
+        AX_CHECK(ToStd(Both) == std::string(_trim(Whole, _space, true, true)));
+        AX_CHECK(ToStd(Left) == std::string(_trim(Whole, _space, true, false)));
+        AX_CHECK(ToStd(Right)
+            == std::string(_trim(Whole, _space, false, true)));
+        AX_CHECK(ToStd(Custom) == std::string(Chars));
+        AX_CHECK(Both.Capacity() == Capacity);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _testEdges(void)
+{
+    TString Empty;
+
+    AX_CHECK(Empty.Trim().Length() == 0 && Empty.TrimView().empty());
+    AX_CHECK(ToStd(TString(" \t x y \r\n").Trim()) == "x y");
+    AX_CHECK(ToStd(TString(" \t\n").TrimLeft()).empty());
+    AX_CHECK(ToStd(TString("--x--").TrimChars(TString("-"))) == "x");
+    AX_CHECK(ToStd(TString("--x--").TrimChars(TString())) == "--x--");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRandom();
+    _testEdges();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+#include "Check.hpp"
+#include "CountNew.hpp"
+#include <cstring>
+#include <random>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+using FMode = TString::UrlMode;
+
+///////////////////////////////////////////////////////////////////////////////
+static const size_t _none = static_cast<size_t>(-1);
+
+///////////////////////////////////////////////////////////////////////////////
+/// The bytes each mode leaves as they are, spelled out as documented.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::string _safe(FMode Mode)
+{
+    const std::string Alnum =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+    if (Mode == FMode::Component)
+        return (Alnum + "-._~");
+    if (Mode == FMode::Path)
+        return (Alnum + "-._~!$&'()*+,;=:@/");
+    return (Alnum + "*-._");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _reference(const std::string& Bytes, FMode Mode)
+{
+    const std::string Safe = _safe(Mode);
+    std::string Encoded;
+    char Escape[4];
+
+    for (char Ch : Bytes)
+    {
+        if (Ch != '\0' && Safe.find(Ch) != std::string::npos)
+            Encoded += Ch;
+        else if (Mode == FMode::Form && Ch == ' ')
+            Encoded += '+';
+        else
+        {
+            std::snprintf(Escape, sizeof(Escape), "%%%02X",
+                static_cast<unsigned char>(Ch));
+            Encoded += Escape;
+        }
+    }
+    return (Encoded);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Random bytes, some mostly safe so that long runs take the vector path,
+/// encoded in every mode and decoded back.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRoundTrip(void)
+{
+    std::mt19937 Rng(46);
+
+    for (int Round = 0; Round < 6000; ++Round)
+    {
+        const FMode Mode = static_cast<FMode>(Round % 3);
+        const std::string Safe = _safe(Mode);
+        const size_t Len = Rng() % (Round % 7 ? 100 : 1000);
+        std::string Bytes;
+
+        for (size_t i = 0; i < Len; ++i)
+        {
+            Bytes += Round % 2 && Rng() % 16 ? Safe[Rng() % Safe.size()]
+                : static_cast<char>(Rng());
+        }
+
+        const TString Str = MakeString(Bytes);
+        const std::string Expected = _reference(Bytes, Mode);
+        TString Encoded;
+        const TAllocations Made = CountAllocations([&]()
+        {
+            Encoded = Str.UrlEncode(Mode);
+        });
+
+        AX_CHECK(ToStd(Encoded) == Expected);
+        AX_CHECK(Made.NewArray == 1);
+        AX_CHECK(ToStd(TString("x").AppendUrlEncode(Bytes.data(), Len, Mode))
+            == "x" + Expected);
+
+        TString Decoded;
+        size_t Offset = 0;
+
+        AX_CHECK(TString::UrlDecode(Expected.data(), Expected.size(), Decoded,
+            Mode, &Offset));
+        AX_CHECK(ToStd(Decoded) == Bytes && Offset == _none);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Lower case escapes and raw bytes decode; a `%` without two hex digits
+/// after it is reported and leaves the output untouched.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testDecode(void)
+{
+    struct FCase
+    {
+        const char* Input;
+        FMode Mode;
+        const char* Output;
+        size_t Offset;
+    };
+    static const FCase Cases[] = {
+        {"a%2fb%2F", FMode::Component, "a/b/", _none},
+        {"a+b", FMode::Component, "a+b", _none},
+        {"a+b%2B", FMode::Form, "a b+", _none},
+        {"caf\xC3\xA9 !", FMode::Path, "caf\xC3\xA9 !", _none},
+        {"%", FMode::Component, nullptr, 0},
+        {"ab%4", FMode::Component, nullptr, 2},
+        {"%41%G1", FMode::Form, nullptr, 3},
+        {"%41%4g", FMode::Path, nullptr, 3},
+        {"x%%41", FMode::Component, nullptr, 1},
+    };
+
+    for (const FCase& Case : Cases)
+    {
+        const size_t Len = std::strlen(Case.Input);
+        TString Out("kept");
+        TString Appended("kept");
+        size_t Offset = 0;
+
+        AX_CHECK(TString::UrlDecode(Case.Input, Len, Out, Case.Mode, &Offset)
+            == (Case.Output != nullptr));
+        AX_CHECK(Offset == Case.Offset);
+        AX_CHECK(ToStd(Out) == (Case.Output ? Case.Output : "kept"));
+        AX_CHECK(Appended.AppendUrlDecode(Case.Input, Len, Case.Mode,
+            &Offset) == (Case.Output != nullptr));
+        AX_CHECK(ToStd(Appended)
+            == (Case.Output ? "kept" + std::string(Case.Output) : "kept"));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testRoundTrip();
+    _testDecode();
+    std::puts("ok");
+    return (0);
+}
@@ -0,0 +1,341 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// MIT License
+///
+/// Copyright(c) 2024 Mallory SCOTTON
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a
+/// copy of this software and associated documentation files (the "Software"),
+/// to deal in the Software without restriction, including without limitation
+/// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+/// and/or sell copies of the Software, and to permit persons to whom the
+/// Software is furnished to do so, subject to the following coditions:
+///
+/// The above copyright notice and this permission notice shall be included
+/// in all copies or substantial portions of the Software?
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+/// DEALINGS IN THE SOFTWARE.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Headers
+///////////////////////////////////////////////////////////////////////////////
+// The validator's vector loop is file-local, so this test builds String.cpp
+// in instead of linking the library.
+#include "../String.cpp"
+#include "Check.hpp"
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using Ax::TString;
+using Ax::sizeType;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Decodes one sequence by the rules of Unicode table 3-7.
+///
+/// \return Its length, or 0 if it is invalid or truncated.
+///
+///////////////////////////////////////////////////////////////////////////////
+static size_t _decode(const std::string& Str, size_t Pos, char32_t& Code)
+{
+    const unsigned char Lead = Str[Pos];
+    size_t Size = 0;
+    unsigned char Low = 0x80;
+    unsigned char High = 0xBF;
+
+    if (Lead < 0x80)
+    {
+        Code = Lead;
+        return (1);
+    }
+    if (Lead >= 0xC2 && Lead <= 0xDF)
+        Size = 2;
+    else if (Lead >= 0xE0 && Lead <= 0xEF)
+        Size = 3;
+    else if (Lead >= 0xF0 && Lead <= 0xF4)
+        Size = 4;
+    else
+        return (0);
+    if (Lead == 0xE0)
+        Low = 0xA0;
+    else if (Lead == 0xED)
+        High = 0x9F;
+    else if (Lead == 0xF0)
+        Low = 0x90;
+    else if (Lead == 0xF4)
+        High = 0x8F;
+    Code = Lead & (0x7F >> Size);
+    for (size_t i = 1; i < Size; ++i)
+    {
+        if (Pos + i >= Str.size())
+            return (0);
+        const unsigned char Byte = Str[Pos + i];
+        if (Byte < (i == 1 ? Low : 0x80) || Byte > (i == 1 ? High : 0xBF))
+            return (0);
+        Code = (Code << 6) | (Byte & 0x3F);
+    }
+    return (Size);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Offset of the first invalid sequence, or `npos`.
+///
+///////////////////////////////////////////////////////////////////////////////
+static sizeType _firstError(const std::string& Str)
+{
+    char32_t Code;
+
+    for (size_t Pos = 0; Pos < Str.size();)
+    {
+        const size_t Size = _decode(Str, Pos, Code);
+        if (!Size)
+            return (Pos);
+        Pos += Size;
+    }
+    return (TString::npos);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static std::string _encode(char32_t Code)
+{
+    std::string Out;
+
+    if (Code < 0x80)
+        Out += char(Code);
+    else if (Code < 0x800)
+    {
+        Out += char(0xC0 | (Code >> 6));
+        Out += char(0x80 | (Code & 0x3F));
+    }
+    else if (Code < 0x10000)
+    {
+        Out += char(0xE0 | (Code >> 12));
+        Out += char(0x80 | ((Code >> 6) & 0x3F));
+        Out += char(0x80 | (Code & 0x3F));
+    }
+    else
+    {
+        Out += char(0xF0 | (Code >> 18));
+        Out += char(0x80 | ((Code >> 12) & 0x3F));
+        Out += char(0x80 | ((Code >> 6) & 0x3F));
+        Out += char(0x80 | (Code & 0x3F));
+    }
+    return (Out);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A random scalar value, mostly outside ASCII.
+///
+///////////////////////////////////////////////////////////////////////////////
+static char32_t _randomCode(std::mt19937& Rng)
+{
+    switch (Rng() % 4)
+    {
+        case 0: return (char32_t(Rng() % 0x80));
+        case 1: return (char32_t(0x80 + Rng() % 0x780));
+        case 2:
+        {
+            const char32_t Code = 0x800 + Rng() % 0xF800;
+            return (Code >= 0xD800 && Code < 0xE000 ? 0xFFFD : Code);
+        }
+        default: return (char32_t(0x10000 + Rng() % 0x100000));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void _checkValidate(const std::string& Str)
+{
+    const sizeType Expected = _firstError(Str);
+    sizeType Offset = 0;
+
+    AX_CHECK(TString::ValidateUtf8(Str.data(), Str.size(), &Offset)
+        == (Expected == TString::npos));
+    AX_CHECK(Offset == Expected);
+    AX_CHECK(MakeString(Str).IsValidUtf8(&Offset) == (Offset == TString::npos));
+    AX_CHECK(Offset == Expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The vector kernels this CPU can run, and the dispatcher.
+///
+///////////////////////////////////////////////////////////////////////////////
+static std::vector<size_t (*)(const char*, size_t)> _prefixKernels(void)
+{
+    std::vector<size_t (*)(const char*, size_t)> Kernels;
+
+    Kernels.push_back(Ax::_utf8VectorPrefix);
+#if defined(AX_AVX2_KERNELS)
+    if (Ax::_cpuHasAvx2())
+        Kernels.push_back(Ax::_utf8PrefixAvx2);
+#endif
+#if defined(AX_SSSE3_KERNELS)
+    if (Ax::_cpuHasSsse3())
+        Kernels.push_back(Ax::_utf8PrefixSsse3);
+#endif
+    return (Kernels);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Valid text must not drop out of the vector loop: every kernel
+/// vouches for every chunk it can see, as it does for ASCII.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testVectorLoopReachesEnd(void)
+{
+    std::mt19937 Rng(42);
+
+    for (int Round = 0; Round < 200; ++Round)
+    {
+        std::string Str;
+        const size_t Target = 64 + Rng() % 4096;
+        while (Str.size() < Target)
+            Str += _encode(_randomCode(Rng));
+
+        const std::string Ascii(Str.size(), 'a');
+        for (auto Kernel : _prefixKernels())
+        {
+            const size_t Expected = Kernel(Ascii.data(), Ascii.size());
+            AX_CHECK(Kernel(Str.data(), Str.size()) == Expected);
+            AX_CHECK(Kernel == Ax::_utf8VectorPrefix || Expected ==
+                Str.size() / 64 * 64);
+        }
+        _checkValidate(Str);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sequences cut by a 64-byte chunk boundary, valid and truncated,
+/// followed by ASCII or by more non-ASCII text.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testChunkBoundaries(void)
+{
+    const char32_t Codes[] = {0xE9, 0x20AC, 0x1F600};
+    const std::string Tails[] = {std::string(80, 'x'), _encode(0xE9) +
+        std::string(70, 'y'), std::string(100, 'z') + _encode(0x1F600)};
+
+    for (size_t Before = 56; Before < 72; ++Before)
+    {
+        for (char32_t Code : Codes)
+        {
+            const std::string Seq = _encode(Code);
+            for (const std::string& Tail : Tails)
+            {
+                const std::string Head(Before, 'a');
+                _checkValidate(Head + Seq + Tail);
+                for (size_t Cut = 1; Cut < Seq.size(); ++Cut)
+                    _checkValidate(Head + Seq.substr(0, Cut) + Tail);
+            }
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Random bytes with a bias towards lead and continuation bytes,
+/// and valid text with one corrupted byte.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testRandom(void)
+{
+    std::mt19937 Rng(7);
+    const unsigned char Special[] = {0x80, 0xBF, 0xC0, 0xC1, 0xC2, 0xDF,
+        0xE0, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF, 0x9F, 0xA0, 0x8F, 0x90};
+
+    for (int Round = 0; Round < 20000; ++Round)
+    {
+        std::string Str;
+        const size_t Len = Rng() % 300;
+        for (size_t i = 0; i < Len; ++i)
+        {
+            Str += Rng() % 2 ? char(Rng() % 0x80)
+                : char(Special[Rng() % sizeof(Special)]);
+        }
+        _checkValidate(Str);
+
+        std::string Text;
+        while (Text.size() < 200)
+            Text += _encode(_randomCode(Rng));
+        Text[Rng() % Text.size()] = char(Special[Rng() % sizeof(Special)]);
+        _checkValidate(Text);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Code point counts, offsets, iteration and UTF-16/32 round trips.
+///
+///////////////////////////////////////////////////////////////////////////////
+static void _testCodePoints(void)
+{
+    std::mt19937 Rng(11);
+
+    for (int Round = 0; Round < 500; ++Round)
+    {
+        std::u32string Codes;
+        std::string Bytes;
+        std::vector<sizeType> Starts;
+        const size_t Count = Rng() % 200;
+        for (size_t i = 0; i < Count; ++i)
+        {
+            Codes += _randomCode(Rng);
+            Starts.push_back(Bytes.size());
+            Bytes += _encode(Codes.back());
+        }
+
+        const TString Str = MakeString(Bytes);
+        AX_CHECK(Str.CodePointCount() == Count);
+        AX_CHECK(Str.ByteOffset(Count) == Bytes.size());
+        AX_CHECK(Str.ByteOffset(Count + 1) == TString::npos);
+        for (size_t i = 0; i < Count; ++i)
+        {
+            AX_CHECK(Str.ByteOffset(i) == Starts[i]);
+            AX_CHECK(Str.CodePointIndex(Starts[i]) == i);
+        }
+
+        size_t Index = 0;
+        for (auto It = Str.CodePointBegin(); It != Str.CodePointEnd(); ++It)
+            AX_CHECK(Index < Count && *It == Codes[Index++]);
+        AX_CHECK(Index == Count);
+
+        std::u32string Utf32;
+        std::u16string Utf16;
+        TString Back;
+        AX_CHECK(Str.ToUtf32(Utf32) && Utf32 == Codes);
+        AX_CHECK(Str.ToUtf16(Utf16));
+        AX_CHECK(TString::FromUtf16(Utf16.data(), Utf16.size(), Back));
+        AX_CHECK(ToStd(Back) == Bytes);
+        AX_CHECK(TString::FromUtf32(Codes.data(), Codes.size(), Back));
+        AX_CHECK(ToStd(Back) == Bytes);
+    }
+
+    // Invalid input reads as U+FFFD, and bad units are reported by index.
+    const TString Bad = MakeString(std::string("a\xC3", 2));
+    auto It = Bad.CodePointBegin();
+    AX_CHECK(*It == U'a' && *++It == 0xFFFD && ++It == Bad.CodePointEnd());
+
+    const char16_t Lone[] = {u'a', 0xDC00, u'b'};
+    const char32_t Large[] = {U'a', U'b', 0x110000};
+    TString Out = MakeString("kept");
+    sizeType Offset = 0;
+    AX_CHECK(!TString::FromUtf16(Lone, 3, Out, &Offset) && Offset == 1);
+    AX_CHECK(!TString::FromUtf32(Large, 3, Out, &Offset) && Offset == 2);
+    AX_CHECK(ToStd(Out) == "kept");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+    _testVectorLoopReachesEnd();
+    _testChunkBoundaries();
+    _testRandom();
+    _testCodePoints();
+    std::puts("ok");
+    return (0);
+}